@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <booleval/column.hpp>
+#include <booleval/evaluator.hpp>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/utils/instruction_set.hpp>
+
+/**
+ * Compares the throughput of evaluating objects one by one (by walking
+ * the expression tree and by executing the compiled program) with the
+ * throughput of evaluating them in batches and as columns of values,
+ * both with scalar column kernels and with the ones selected for the CPU.
+ */
+
+struct obj {
+public:
+    obj(uint32_t const field_a, uint32_t const field_b)
+        : field_a_(field_a),
+          field_b_(field_b)
+    {}
+
+    uint32_t field_a() const noexcept {
+        return field_a_;
+    }
+
+    uint32_t field_b() const noexcept {
+        return field_b_;
+    }
+
+private:
+    uint32_t field_a_;
+    uint32_t field_b_;
+};
+
+template <typename F>
+double measure(std::size_t const count_of_objects, F&& func) {
+    auto const start = std::chrono::steady_clock::now();
+    func();
+    auto const end = std::chrono::steady_clock::now();
+
+    return count_of_objects / std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+int main() {
+    constexpr std::size_t count_of_objects{ 1000000 };
+
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<uint32_t> distribution{ 0, 99 };
+
+    std::vector<obj> objects;
+    std::vector<uint32_t> field_a;
+    std::vector<uint32_t> field_b;
+    objects.reserve(count_of_objects);
+    for (std::size_t i = 0; i < count_of_objects; ++i) {
+        objects.emplace_back(distribution(generator), distribution(generator));
+        field_a.push_back(objects.back().field_a());
+        field_b.push_back(objects.back().field_b());
+    }
+
+    std::map<std::string_view, booleval::column> const columns{
+        { "field_a", booleval::column(field_a.data(), field_a.size()) },
+        { "field_b", booleval::column(field_b.data(), field_b.size()) }
+    };
+
+    booleval::evaluator evaluator({
+        { "field_a", &obj::field_a },
+        { "field_b", &obj::field_b }
+    });
+
+    std::cout << std::left
+              << std::setw(56) << "expression"
+              << std::setw(16) << "tree [Mobj/s]"
+              << std::setw(20) << "bytecode [Mobj/s]"
+              << std::setw(18) << "batch [Mobj/s]"
+              << std::setw(20) << "scalar [Mrow/s]"
+              << "simd [Mrow/s]" << std::endl;
+
+    auto const instruction_set = booleval::utils::supported_instruction_set();
+
+    for (std::string const expression : { "field_a lt 50",
+                                          "field_a lt 50 and field_b gt 20",
+                                          "field_a lt 5 or field_b gt 95 or field_a 42",
+                                          "(field_a geq 10 and field_a leq 20) or field_b neq 7" }) {
+        if (!evaluator.expression(expression)) {
+            std::cerr << "Expression not valid!" << std::endl;
+            return 1;
+        }
+
+        std::size_t tree_matches{ 0 };
+        std::size_t bytecode_matches{ 0 };
+        booleval::utils::bitmap result;
+        booleval::utils::bitmap columnar_result;
+
+        evaluator.strategy(booleval::tree::evaluation_strategy::tree_walk);
+        auto const tree = measure(count_of_objects, [&] {
+            for (auto const& o : objects) {
+                tree_matches += evaluator.evaluate(o) ? 1 : 0;
+            }
+        });
+
+        evaluator.strategy(booleval::tree::evaluation_strategy::bytecode);
+        auto const bytecode = measure(count_of_objects, [&] {
+            for (auto const& o : objects) {
+                bytecode_matches += evaluator.evaluate(o) ? 1 : 0;
+            }
+        });
+
+        auto const batch = measure(count_of_objects, [&] {
+            evaluator.evaluate_batch(objects.data(), objects.size(), result);
+        });
+
+        booleval::utils::active_instruction_set(booleval::utils::instruction_set::scalar);
+        auto const scalar = measure(count_of_objects, [&] {
+            evaluator.evaluate_columns(columns, columnar_result);
+        });
+
+        booleval::utils::active_instruction_set(instruction_set);
+        auto const simd = measure(count_of_objects, [&] {
+            evaluator.evaluate_columns(columns, columnar_result);
+        });
+
+        auto const consistent =
+            tree_matches == bytecode_matches &&
+            tree_matches == result.count() &&
+            tree_matches == columnar_result.count();
+
+        if (!consistent) {
+            std::cerr << "Evaluation strategies produced different results!" << std::endl;
+            return 1;
+        }
+
+        std::cout << std::left << std::fixed << std::setprecision(1)
+                  << std::setw(56) << expression
+                  << std::setw(16) << tree
+                  << std::setw(20) << bytecode
+                  << std::setw(18) << batch
+                  << std::setw(20) << scalar
+                  << simd << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <utility>
+#include <iostream>
+#include <string_view>
+#include <booleval/evaluator.hpp>
+#include <booleval/token/tokenizer.hpp>
+#include <booleval/tree/expression_tree.hpp>
+#include <booleval/utils/instruction_set.hpp>
+#include "perf_counters.hpp"
+
+/**
+ * Measures tokenizing expressions, building their expression trees and
+ * evaluating objects against them, for expressions of different sizes over
+ * different numbers and types of fields, and with different selectivities.
+ * Results are written as JSON, so that releases can be compared.
+ *
+ * With --counters, hardware counters are collected as well and reported per
+ * evaluated object, or per call of tokenize and build.
+ *
+ * Usage: booleval_bench [--objects=N] [--repetitions=N] [--filter=NAME] [--output=FILE] [--counters]
+ */
+
+namespace {
+
+constexpr std::size_t max_fields{ 16 };
+constexpr uint32_t max_value{ 1000000 };
+
+constexpr std::array<std::size_t, 3> term_counts{ 10, 100, 1000 };
+constexpr std::array<std::size_t, 3> field_counts{ 1, 4, 16 };
+constexpr std::array<double, 3> selectivities{ 0.01, 0.5, 0.99 };
+
+enum class field_type {
+    uint32,
+    float64,
+    string
+};
+
+constexpr std::array<field_type, 3> field_types{ field_type::uint32, field_type::float64, field_type::string };
+
+std::string_view to_string(field_type const type) {
+    switch (type) {
+    case field_type::uint32:
+        return "uint32";
+    case field_type::float64:
+        return "float64";
+    default:
+        return "string";
+    }
+}
+
+std::string format_string_value(uint32_t const value) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "v%07u", static_cast<unsigned>(value));
+    return buffer;
+}
+
+/**
+ * Zero padded strings, so that comparing them orders them as their numbers.
+ */
+std::vector<std::string> const string_values = [] {
+    std::vector<std::string> values;
+    values.reserve(max_value);
+    for (uint32_t i = 0; i < max_value; ++i) {
+        values.push_back(format_string_value(i));
+    }
+    return values;
+}();
+
+std::array<std::string, max_fields> const field_names = [] {
+    std::array<std::string, max_fields> names;
+    for (std::size_t i = 0; i < max_fields; ++i) {
+        names[i] = "field_" + std::to_string(i);
+    }
+    return names;
+}();
+
+/**
+ * Every field of the record holds a uniformly distributed number,
+ * which is exposed as an integer, a floating point number or a string.
+ */
+struct record {
+    std::array<uint32_t, max_fields> values;
+
+    template <std::size_t I>
+    uint32_t as_uint32() const noexcept {
+        return values[I];
+    }
+
+    template <std::size_t I>
+    double as_float64() const noexcept {
+        return values[I] + 0.5;
+    }
+
+    template <std::size_t I>
+    std::string_view as_string() const noexcept {
+        return string_values[values[I]];
+    }
+};
+
+using field_map = std::map<std::string_view, booleval::utils::any_mem_fn>;
+
+template <std::size_t... I>
+field_map make_fields(field_type const type, std::size_t const count, std::index_sequence<I...>) {
+    field_map fields;
+    auto add = [&](std::size_t const index, auto&& uint32_fn, auto&& float64_fn, auto&& string_fn) {
+        if (index >= count) {
+            return;
+        }
+        switch (type) {
+        case field_type::uint32:
+            fields.emplace(field_names[index], uint32_fn);
+            break;
+        case field_type::float64:
+            fields.emplace(field_names[index], float64_fn);
+            break;
+        default:
+            fields.emplace(field_names[index], string_fn);
+            break;
+        }
+    };
+    (add(I, &record::as_uint32<I>, &record::as_float64<I>, &record::as_string<I>), ...);
+    return fields;
+}
+
+field_map make_fields(field_type const type, std::size_t const count) {
+    return make_fields(type, count, std::make_index_sequence<max_fields>{});
+}
+
+/**
+ * Builds a disjunction of terms spread over the fields. All the terms on the
+ * same field are equal, so each field is satisfied with the same probability,
+ * chosen so that, the fields being independent, the whole expression is
+ * satisfied by the requested fraction of the objects.
+ */
+std::string make_expression(std::size_t const terms, std::size_t const fields,
+                            field_type const type, double const selectivity) {
+    auto const distinct = static_cast<double>(std::min(terms, fields));
+    auto const fraction = 1.0 - std::pow(1.0 - selectivity, 1.0 / distinct);
+    auto const threshold = static_cast<uint32_t>(std::lround(fraction * max_value));
+
+    std::string literal = type == field_type::string
+        ? format_string_value(threshold)
+        : std::to_string(threshold);
+
+    std::string expression;
+    for (std::size_t i = 0; i < terms; ++i) {
+        if (0 != i) {
+            expression += " or ";
+        }
+        expression += field_names[i % fields];
+        expression += " lt ";
+        expression += literal;
+    }
+    return expression;
+}
+
+struct options {
+    std::size_t objects{ 1000000 };
+    std::size_t repetitions{ 3 };
+    std::string filter;
+    std::string output;
+    bool counters{ false };
+};
+
+bool parse_options(int argc, char* argv[], options& result) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const arg{ argv[i] };
+        auto value = [arg](std::string_view const name) {
+            return arg.substr(name.size());
+        };
+
+        if (0 == arg.rfind("--objects=", 0)) {
+            result.objects = std::stoul(std::string(value("--objects=")));
+        } else if (0 == arg.rfind("--repetitions=", 0)) {
+            result.repetitions = std::max<std::size_t>(1, std::stoul(std::string(value("--repetitions="))));
+        } else if (0 == arg.rfind("--filter=", 0)) {
+            result.filter = value("--filter=");
+        } else if (0 == arg.rfind("--output=", 0)) {
+            result.output = value("--output=");
+        } else if ("--counters" == arg) {
+            result.counters = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct measurement {
+    std::size_t iterations;
+    double seconds;
+    perf_counters::reading counters;
+};
+
+/**
+ * Runs the function repeatedly, until it has run for at least the minimum
+ * time, and reports the best time of a single run out of all repetitions.
+ * Hardware counters are averaged over all the units processed by all the runs.
+ */
+template <typename F>
+measurement measure(std::size_t const repetitions, perf_counters& counters,
+                    std::size_t const units_per_run, F&& func) {
+    using clock = std::chrono::steady_clock;
+    constexpr std::chrono::duration<double> min_time{ 0.05 };
+
+    counters.start();
+
+    std::size_t iterations{ 0 };
+    auto best = std::numeric_limits<double>::max();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+        auto const start = clock::now();
+        auto now = start;
+        std::size_t runs{ 0 };
+        do {
+            func();
+            ++runs;
+            now = clock::now();
+        } while (now - start < min_time);
+
+        iterations += runs;
+        best = std::min(best, std::chrono::duration<double>(now - start).count() / runs);
+    }
+
+    auto const units = static_cast<double>(iterations) * static_cast<double>(units_per_run);
+    return { iterations, best, counters.stop(units) };
+}
+
+/**
+ * Writes benchmark results as an array of JSON objects.
+ */
+class json_writer {
+public:
+    explicit json_writer(std::ostream& out)
+        : out_(out)
+    {}
+
+    void begin(options const& opts, perf_counters const& counters) {
+        counters_ = opts.counters;
+
+        out_ << "{\n"
+             << "  \"context\": {\n"
+             << "    \"objects\": " << opts.objects << ",\n"
+             << "    \"repetitions\": " << opts.repetitions << ",\n"
+             << "    \"instruction_set\": \"" << instruction_set_name() << "\",\n"
+             << "    \"counters\": " << (counters.available() ? "true" : "false") << "\n"
+             << "  },\n"
+             << "  \"benchmarks\": [";
+    }
+
+    template <typename... Fields>
+    void record(Fields&&... fields) {
+        out_ << (first_ ? "\n" : ",\n") << "    {";
+        first_ = false;
+
+        bool first_field{ true };
+        auto write = [&](auto const& field) {
+            out_ << (first_field ? " " : ", ");
+            first_field = false;
+            out_ << '"' << field.first << "\": ";
+            write_value(field.second);
+        };
+        (write(fields), ...);
+
+        out_ << " }" << std::flush;
+    }
+
+    void end() {
+        out_ << "\n  ]\n}\n";
+    }
+
+private:
+    static std::string_view instruction_set_name() {
+        switch (booleval::utils::active_instruction_set()) {
+        case booleval::utils::instruction_set::avx2:
+            return "avx2";
+        case booleval::utils::instruction_set::sse42:
+            return "sse4.2";
+        default:
+            return "scalar";
+        }
+    }
+
+    void write_value(std::string_view const value) {
+        out_ << '"' << value << '"';
+    }
+
+    void write_value(double const value) {
+        out_ << value;
+    }
+
+    void write_value(std::size_t const value) {
+        out_ << value;
+    }
+
+    void write_value(perf_counters::reading const& value) {
+        if (!counters_) {
+            out_ << "null";
+            return;
+        }
+
+        out_ << "{ ";
+        for (std::size_t i = 0; i < perf_counters::count_of_events; ++i) {
+            out_ << (0 == i ? "" : ", ") << '"' << perf_counters::name(i) << "\": ";
+            if (value.values[i]) {
+                out_ << *value.values[i];
+            } else {
+                out_ << "null";
+            }
+        }
+        out_ << " }";
+    }
+
+private:
+    std::ostream& out_;
+    bool first_{ true };
+    bool counters_{ false };
+};
+
+template <typename T>
+std::pair<std::string_view, T> field(std::string_view const name, T const& value) {
+    return { name, value };
+}
+
+bool selected(options const& opts, std::string_view const name) {
+    return opts.filter.empty() || std::string_view::npos != name.find(opts.filter);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    options opts;
+    if (!parse_options(argc, argv, opts)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--objects=N] [--repetitions=N] [--filter=NAME] [--output=FILE] [--counters]" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!opts.output.empty()) {
+        file.open(opts.output);
+        if (!file) {
+            std::cerr << "Cannot open " << opts.output << std::endl;
+            return 1;
+        }
+    }
+
+    perf_counters counters(opts.counters);
+    if (opts.counters && !counters.available()) {
+        std::cerr << "Hardware counters are not available, only time is measured" << std::endl;
+    }
+
+    json_writer writer(opts.output.empty() ? std::cout : file);
+    writer.begin(opts, counters);
+
+    for (auto const type : field_types) {
+        for (auto const terms : term_counts) {
+            auto const expression = make_expression(terms, max_fields, type, selectivities[1]);
+
+            if (selected(opts, "tokenize")) {
+                booleval::token::tokenizer tokenizer(expression);
+                auto const [iterations, seconds, counts] = measure(opts.repetitions, counters, 1, [&] {
+                    tokenizer.tokenize();
+                });
+
+                auto const tokens = booleval::token::tokenizer::tokenize(expression, nullptr, 0);
+
+                writer.record(
+                    field("name", std::string_view{ "tokenize" }),
+                    field("field_type", to_string(type)),
+                    field("terms", terms),
+                    field("bytes", expression.size()),
+                    field("tokens", tokens),
+                    field("iterations", iterations),
+                    field("seconds", seconds),
+                    field("bytes_per_second", expression.size() / seconds),
+                    field("counters", counts)
+                );
+            }
+
+            if (selected(opts, "build")) {
+                booleval::tree::expression_tree tree;
+                auto const [iterations, seconds, counts] = measure(opts.repetitions, counters, 1, [&] {
+                    if (!tree.build(expression)) {
+                        std::abort();
+                    }
+                });
+
+                writer.record(
+                    field("name", std::string_view{ "build" }),
+                    field("field_type", to_string(type)),
+                    field("terms", terms),
+                    field("bytes", expression.size()),
+                    field("nodes", tree.nodes().size()),
+                    field("iterations", iterations),
+                    field("seconds", seconds),
+                    field("bytes_per_second", expression.size() / seconds),
+                    field("counters", counts)
+                );
+            }
+        }
+    }
+
+    if (!selected(opts, "evaluate")) {
+        writer.end();
+        return 0;
+    }
+
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<uint32_t> distribution{ 0, max_value - 1 };
+
+    std::vector<record> objects(opts.objects);
+    for (auto& object : objects) {
+        for (auto& value : object.values) {
+            value = distribution(generator);
+        }
+    }
+
+    for (auto const type : field_types) {
+        for (auto const fields : field_counts) {
+            booleval::evaluator evaluator(make_fields(type, fields));
+
+            for (auto const terms : term_counts) {
+                for (auto const selectivity : selectivities) {
+                    if (!evaluator.expression(make_expression(terms, fields, type, selectivity))) {
+                        std::cerr << "Expression not valid!" << std::endl;
+                        return 1;
+                    }
+
+                    std::size_t matches{ 0 };
+                    auto const [iterations, seconds, counts] = measure(opts.repetitions, counters, objects.size(), [&] {
+                        matches = 0;
+                        for (auto const& object : objects) {
+                            matches += evaluator.evaluate(object) ? 1 : 0;
+                        }
+                    });
+
+                    writer.record(
+                        field("name", std::string_view{ "evaluate" }),
+                        field("field_type", to_string(type)),
+                        field("terms", terms),
+                        field("fields", fields),
+                        field("selectivity", selectivity),
+                        field("matched", objects.empty() ? 0.0 : static_cast<double>(matches) / objects.size()),
+                        field("objects", objects.size()),
+                        field("iterations", iterations),
+                        field("seconds", seconds),
+                        field("objects_per_second", objects.size() / seconds),
+                        field("counters", counts)
+                    );
+                }
+            }
+        }
+    }
+
+    writer.end();
+    return 0;
+}
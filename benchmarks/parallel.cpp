@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <booleval/evaluator.hpp>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/utils/thread_pool.hpp>
+
+/**
+ * Measures how the throughput of evaluating a large sequence of objects
+ * scales with the number of threads evaluating its chunks in parallel.
+ */
+
+struct obj {
+public:
+    obj(uint32_t const field_a, uint32_t const field_b)
+        : field_a_(field_a),
+          field_b_(field_b)
+    {}
+
+    uint32_t field_a() const noexcept {
+        return field_a_;
+    }
+
+    uint32_t field_b() const noexcept {
+        return field_b_;
+    }
+
+private:
+    uint32_t field_a_;
+    uint32_t field_b_;
+};
+
+int main() {
+    constexpr std::size_t count_of_objects{ 10000000 };
+
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<uint32_t> distribution{ 0, 99 };
+
+    std::vector<obj> objects;
+    objects.reserve(count_of_objects);
+    for (std::size_t i = 0; i < count_of_objects; ++i) {
+        objects.emplace_back(distribution(generator), distribution(generator));
+    }
+
+    booleval::evaluator evaluator({
+        { "field_a", &obj::field_a },
+        { "field_b", &obj::field_b }
+    });
+
+    if (!evaluator.expression("(field_a geq 10 and field_a leq 20) or field_b neq 7")) {
+        std::cerr << "Expression not valid!" << std::endl;
+        return 1;
+    }
+
+    booleval::utils::bitmap expected;
+    evaluator.evaluate_batch(objects.data(), objects.size(), expected);
+
+    std::cout << std::left
+              << std::setw(12) << "threads"
+              << std::setw(16) << "[Mobj/s]"
+              << "speedup" << std::endl;
+
+    double baseline{ 0 };
+    auto const threads = std::max(1U, std::thread::hardware_concurrency());
+    for (std::size_t concurrency = 1; concurrency <= threads; concurrency *= 2) {
+        booleval::utils::thread_pool pool(concurrency - 1);
+        booleval::utils::bitmap result;
+
+        auto const start = std::chrono::steady_clock::now();
+        evaluator.evaluate_parallel(objects.data(), objects.size(), result, pool);
+        auto const end = std::chrono::steady_clock::now();
+
+        if (result.count() != expected.count()) {
+            std::cerr << "Parallel evaluation produced different results!" << std::endl;
+            return 1;
+        }
+
+        auto const throughput = count_of_objects / std::chrono::duration<double, std::micro>(end - start).count();
+        if (1 == concurrency) {
+            baseline = throughput;
+        }
+
+        std::cout << std::left << std::fixed << std::setprecision(1)
+                  << std::setw(12) << pool.concurrency()
+                  << std::setw(16) << throughput
+                  << std::setprecision(2) << throughput / baseline << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BENCHMARKS_PERF_COUNTERS_H
+#define BOOLEVAL_BENCHMARKS_PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#if defined(__linux__)
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <linux/perf_event.h>
+#endif
+
+/**
+ * class perf_counters
+ *
+ * Represents the hardware counters of the calling thread, collected through
+ * perf_event_open on Linux. Counters that cannot be opened, because the
+ * kernel, the CPU or the permissions do not allow it, are reported as missing
+ * instead of failing the benchmark.
+ */
+class perf_counters {
+public:
+    static constexpr std::size_t count_of_events{ 4 };
+
+    /**
+     * struct reading
+     *
+     * Represents the counter values divided by the number of measured units,
+     * or missing values for the counters which are not available.
+     */
+    struct reading {
+        std::array<std::optional<double>, count_of_events> values{};
+    };
+
+    explicit perf_counters(bool const enabled) {
+        descriptors_.fill(-1);
+#if defined(__linux__)
+        if (!enabled) {
+            return;
+        }
+
+        for (std::size_t i = 0; i < count_of_events; ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = events[i].type;
+            attr.config = events[i].config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            descriptors_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#else
+        static_cast<void>(enabled);
+#endif
+    }
+
+    perf_counters(perf_counters&& rhs) = delete;
+    perf_counters(perf_counters const& rhs) = delete;
+
+    perf_counters& operator=(perf_counters&& rhs) = delete;
+    perf_counters& operator=(perf_counters const& rhs) = delete;
+
+    ~perf_counters() {
+#if defined(__linux__)
+        for (auto const fd : descriptors_) {
+            if (-1 != fd) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Gets the name of the event counted by the specified counter.
+     *
+     * @param index Index of the counter
+     *
+     * @return Event name
+     */
+    [[nodiscard]] static std::string_view name(std::size_t const index) noexcept {
+        constexpr std::array<std::string_view, count_of_events> names{
+            "cycles", "instructions", "branch_misses", "llc_misses"
+        };
+        return names[index];
+    }
+
+    /**
+     * Checks whether any of the counters is available.
+     *
+     * @return True if at least one counter is available, false otherwise
+     */
+    [[nodiscard]] bool available() const noexcept {
+        for (auto const fd : descriptors_) {
+            if (-1 != fd) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Resets and starts all the available counters.
+     */
+    void start() noexcept {
+#if defined(__linux__)
+        for (auto const fd : descriptors_) {
+            if (-1 != fd) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Stops all the available counters and reads their values. Values of counters
+     * that were multiplexed with other events are scaled to the whole measurement.
+     *
+     * @param units Number of measured units to divide the values by
+     *
+     * @return Counter values per unit
+     */
+    [[nodiscard]] reading stop(double const units) noexcept {
+        reading result;
+#if defined(__linux__)
+        for (std::size_t i = 0; i < count_of_events; ++i) {
+            auto const fd = descriptors_[i];
+            if (-1 == fd) {
+                continue;
+            }
+
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            struct {
+                uint64_t value;
+                uint64_t time_enabled;
+                uint64_t time_running;
+            } data{};
+
+            if (sizeof(data) != read(fd, &data, sizeof(data)) || 0 == data.time_running || 0 >= units) {
+                continue;
+            }
+
+            auto const scale = static_cast<double>(data.time_enabled) / static_cast<double>(data.time_running);
+            result.values[i] = static_cast<double>(data.value) * scale / units;
+        }
+#else
+        static_cast<void>(units);
+#endif
+        return result;
+    }
+
+private:
+#if defined(__linux__)
+    struct event {
+        uint32_t type;
+        uint64_t config;
+    };
+
+    static constexpr std::array<event, count_of_events> events{{
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+                              PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                              PERF_COUNT_HW_CACHE_RESULT_MISS << 16 }
+    }};
+#endif
+
+    std::array<int, count_of_events> descriptors_{};
+};
+
+#endif // BOOLEVAL_BENCHMARKS_PERF_COUNTERS_H
\ No newline at end of file
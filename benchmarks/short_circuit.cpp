@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <booleval/evaluator.hpp>
+
+/**
+ * Measures the cost of evaluating deep AND / OR chains in short-circuit
+ * and eager evaluation modes, as well as by executing the compiled program.
+ * The first operand of every chain decides the result for ~95% of objects.
+ */
+
+struct obj {
+public:
+    obj(uint32_t const field_a, uint32_t const field_b)
+        : field_a_(field_a),
+          field_b_(field_b)
+    {}
+
+    uint32_t field_a() const noexcept {
+        return field_a_;
+    }
+
+    uint32_t field_b() const noexcept {
+        return field_b_;
+    }
+
+private:
+    uint32_t field_a_;
+    uint32_t field_b_;
+};
+
+std::string make_chain(std::string const& first, std::string const& op, std::size_t const depth) {
+    std::string expression{ first };
+    for (std::size_t i = 1; i < depth; ++i) {
+        expression += " " + op + " field_b lt " + std::to_string(1000 + i);
+    }
+    return expression;
+}
+
+template <typename MemFn>
+double measure(booleval::evaluator<MemFn>& evaluator, std::vector<obj> const& objects, std::size_t& matches) {
+    auto const start = std::chrono::steady_clock::now();
+    for (auto const& o : objects) {
+        matches += evaluator.evaluate(o) ? 1 : 0;
+    }
+    auto const end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / objects.size();
+}
+
+int main() {
+    constexpr std::size_t count_of_objects{ 200000 };
+
+    std::mt19937 generator{ 42 };
+    std::uniform_int_distribution<uint32_t> distribution{ 0, 99 };
+
+    std::vector<obj> objects;
+    objects.reserve(count_of_objects);
+    for (std::size_t i = 0; i < count_of_objects; ++i) {
+        objects.emplace_back(distribution(generator), distribution(generator));
+    }
+
+    booleval::evaluator evaluator({
+        { "field_a", &obj::field_a },
+        { "field_b", &obj::field_b }
+    });
+
+    std::cout << std::left
+              << std::setw(6)  << "op"
+              << std::setw(8)  << "depth"
+              << std::setw(18) << "eager [ns/obj]"
+              << std::setw(18) << "short [ns/obj]"
+              << std::setw(20) << "bytecode [ns/obj]"
+              << "speedup" << std::endl;
+
+    for (auto const& [op, first] : { std::make_pair("and", "field_a lt 5"),
+                                     std::make_pair("or",  "field_a geq 5") }) {
+        for (std::size_t depth : { 2, 4, 8, 16, 32 }) {
+            auto const expression = make_chain(first, op, depth);
+            if (!evaluator.expression(expression)) {
+                std::cerr << "Expression not valid!" << std::endl;
+                return 1;
+            }
+
+            std::size_t eager_matches{ 0 };
+            std::size_t short_matches{ 0 };
+            std::size_t bytecode_matches{ 0 };
+
+            evaluator.mode(booleval::tree::evaluation_mode::eager);
+            auto const eager = measure(evaluator, objects, eager_matches);
+
+            evaluator.mode(booleval::tree::evaluation_mode::short_circuit);
+            auto const short_circuit = measure(evaluator, objects, short_matches);
+
+            evaluator.strategy(booleval::tree::evaluation_strategy::bytecode);
+            auto const bytecode = measure(evaluator, objects, bytecode_matches);
+            evaluator.strategy(booleval::tree::evaluation_strategy::tree_walk);
+
+            if (eager_matches != short_matches || short_matches != bytecode_matches) {
+                std::cerr << "Evaluation modes produced different results!" << std::endl;
+                return 1;
+            }
+
+            std::cout << std::left << std::fixed << std::setprecision(1)
+                      << std::setw(6)  << op
+                      << std::setw(8)  << depth
+                      << std::setw(18) << eager
+                      << std::setw(18) << short_circuit
+                      << std::setw(20) << bytecode
+                      << std::setprecision(2) << eager / short_circuit << "x" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_COLUMN_H
+#define BOOLEVAL_COLUMN_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace booleval {
+
+/**
+ * enum class column_type
+ *
+ * Represents the type of the elements of the column.
+ */
+enum class [[nodiscard]] column_type : uint8_t {
+    unknown     = 0,
+    boolean     = 1,
+    int8        = 2,
+    int16       = 3,
+    int32       = 4,
+    int64       = 5,
+    uint8       = 6,
+    uint16      = 7,
+    uint32      = 8,
+    uint64      = 9,
+    float32     = 10,
+    float64     = 11,
+    string      = 12,
+    string_view = 13
+};
+
+/**
+ * Gets the column type representing the type of the elements.
+ *
+ * @return Column type
+ */
+template <typename T>
+[[nodiscard]] constexpr column_type column_type_of() noexcept {
+    using U = std::remove_cv_t<T>;
+
+    if constexpr (std::is_same_v<U, bool>) {
+        return column_type::boolean;
+    } else if constexpr (std::is_same_v<U, int8_t>) {
+        return column_type::int8;
+    } else if constexpr (std::is_same_v<U, int16_t>) {
+        return column_type::int16;
+    } else if constexpr (std::is_same_v<U, int32_t>) {
+        return column_type::int32;
+    } else if constexpr (std::is_same_v<U, int64_t>) {
+        return column_type::int64;
+    } else if constexpr (std::is_same_v<U, uint8_t>) {
+        return column_type::uint8;
+    } else if constexpr (std::is_same_v<U, uint16_t>) {
+        return column_type::uint16;
+    } else if constexpr (std::is_same_v<U, uint32_t>) {
+        return column_type::uint32;
+    } else if constexpr (std::is_same_v<U, uint64_t>) {
+        return column_type::uint64;
+    } else if constexpr (std::is_same_v<U, float>) {
+        return column_type::float32;
+    } else if constexpr (std::is_same_v<U, double>) {
+        return column_type::float64;
+    } else if constexpr (std::is_same_v<U, std::string>) {
+        return column_type::string;
+    } else if constexpr (std::is_same_v<U, std::string_view>) {
+        return column_type::string_view;
+    } else {
+        return column_type::unknown;
+    }
+}
+
+/**
+ * class column
+ *
+ * Represents a typed, non-owning view of the field's values laid out in memory
+ * one after another, either contiguously (structure of arrays) or with a constant
+ * stride between them (e.g. a data member of the objects in an array).
+ */
+class column {
+public:
+    column() = default;
+    column(column&& rhs) = default;
+    column(column const& rhs) = default;
+
+    /**
+     * Creates the column of values.
+     *
+     * @param data   Pointer to the first value
+     * @param size   Number of values
+     * @param stride Distance between two consecutive values in bytes
+     */
+    template <typename T>
+    column(T const* data, std::size_t const size, std::size_t const stride = sizeof(T)) noexcept
+        : data_(data),
+          size_(size),
+          stride_(stride),
+          type_(column_type_of<T>()) {
+        static_assert(column_type::unknown != column_type_of<T>(), "Column type not supported");
+    }
+
+    column& operator=(column&& rhs) = default;
+    column& operator=(column const& rhs) = default;
+
+    ~column() = default;
+
+    /**
+     * Gets the pointer to the first value.
+     *
+     * @return Pointer to the first value
+     */
+    [[nodiscard]] void const* data() const noexcept {
+        return data_;
+    }
+
+    /**
+     * Gets the number of values.
+     *
+     * @return Number of values
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /**
+     * Gets the distance between two consecutive values in bytes.
+     *
+     * @return Distance between two consecutive values
+     */
+    [[nodiscard]] std::size_t stride() const noexcept {
+        return stride_;
+    }
+
+    /**
+     * Gets the type of the values.
+     *
+     * @return Type of the values
+     */
+    [[nodiscard]] column_type type() const noexcept {
+        return type_;
+    }
+
+    /**
+     * Invokes the visitor with the pointer to the first value of its actual type.
+     *
+     * @param visitor Callable accepting the pointer to the value of any of the supported types
+     *
+     * @return Result of the visitor
+     */
+    template <typename Visitor>
+    decltype(auto) visit(Visitor&& visitor) const {
+        switch (type_) {
+        case column_type::boolean:     return visitor(static_cast<bool const*>(data_));
+        case column_type::int8:        return visitor(static_cast<int8_t const*>(data_));
+        case column_type::int16:       return visitor(static_cast<int16_t const*>(data_));
+        case column_type::int32:       return visitor(static_cast<int32_t const*>(data_));
+        case column_type::int64:       return visitor(static_cast<int64_t const*>(data_));
+        case column_type::uint8:       return visitor(static_cast<uint8_t const*>(data_));
+        case column_type::uint16:      return visitor(static_cast<uint16_t const*>(data_));
+        case column_type::uint32:      return visitor(static_cast<uint32_t const*>(data_));
+        case column_type::uint64:      return visitor(static_cast<uint64_t const*>(data_));
+        case column_type::float32:     return visitor(static_cast<float const*>(data_));
+        case column_type::float64:     return visitor(static_cast<double const*>(data_));
+        case column_type::string:      return visitor(static_cast<std::string const*>(data_));
+        case column_type::string_view: return visitor(static_cast<std::string_view const*>(data_));
+        default:                       return visitor(static_cast<bool const*>(nullptr));
+        }
+    }
+
+private:
+    void const* data_{ nullptr };
+    std::size_t size_{ 0 };
+    std::size_t stride_{ 0 };
+    column_type type_{ column_type::unknown };
+};
+
+} // booleval
+
+#endif // BOOLEVAL_COLUMN_H
\ No newline at end of file
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_COMPILED_EXPRESSION_H
+#define BOOLEVAL_COMPILED_EXPRESSION_H
+
+#include <map>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <string_view>
+#include <booleval/exceptions.hpp>
+#include <booleval/tree/program.hpp>
+#include <booleval/tree/reorder.hpp>
+#include <booleval/tree/column_visitor.hpp>
+#include <booleval/tree/node_profiler.hpp>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/utils/any_mem_fn.hpp>
+#include <booleval/utils/selection.hpp>
+#include <booleval/utils/thread_pool.hpp>
+#include <booleval/tree/result_visitor.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+namespace booleval {
+
+/**
+ * class compiled_expression
+ *
+ * Represents an expression compiled for the set of fields, together with
+ * the evaluation mode and strategy. It owns the text of the expression and
+ * is never modified after it is constructed, so a single instance can be
+ * shared (e.g. through std::shared_ptr) and evaluated from any number of
+ * threads at the same time without locking. Evaluation keeps all its
+ * intermediate state on the stack, so no per-thread context is required.
+ *
+ * Since the expression tree refers to the owned text, the compiled
+ * expression can neither be copied nor moved.
+ *
+ * When compiled with profiling enabled, evaluations of objects (one by one
+ * or in batches) are counted per operation of the expression, which can be
+ * reported at any time. The program is then compiled as profiled, so it
+ * keeps being executed if selected, while the columnar evaluation is never
+ * profiled.
+ * Statistics of a profiled expression can be used to compile it again with
+ * the operands of AND and OR operations reordered, which is how evaluator and
+ * expression_holder adapt the expression to the objects being evaluated.
+ */
+template <typename MemFn = utils::any_mem_fn>
+class compiled_expression {
+    using field_map = std::map<std::string_view, MemFn>;
+    using column_map = tree::column_visitor::column_map;
+
+public:
+    static constexpr std::size_t objects_per_chunk{ 16384 };
+    static constexpr uint64_t adaptation_period{ 4096 };
+
+    /**
+     * Compiles the expression for the fields.
+     *
+     * @param expression Expression to be compiled (copied into the compiled expression)
+     * @param fields     Key - member function map
+     * @param mode       Evaluation mode used for logical operations
+     * @param strategy   Strategy used for evaluation of the expression
+     * @param profiling  Whether the evaluations of the expression's operations are counted
+     *
+     * @throws invalid_expression if the expression is not valid
+     * @throws field_not_found if the expression refers to a field that does not exist
+     */
+    compiled_expression(std::string_view expression,
+                        field_map const& fields,
+                        tree::evaluation_mode const mode = tree::evaluation_mode::short_circuit,
+                        tree::evaluation_strategy const strategy = tree::evaluation_strategy::tree_walk,
+                        bool const profiling = false)
+        : text_(expression),
+          strategy_(strategy) {
+        if (!expression_tree_.build(text_)) {
+            throw invalid_expression(text_);
+        }
+
+        if (profiling) {
+            profiler_ = std::make_unique<tree::node_profiler>(expression_tree_.nodes().size());
+            result_visitor_.profiler(profiler_.get());
+        }
+
+        result_visitor_.fields(fields);
+        result_visitor_.mode(mode);
+        column_visitor_.mode(mode);
+
+        result_visitor_.resolve(expression_tree_, *expression_tree_.root());
+        program_.compile(expression_tree_, nullptr != profiler_);
+    }
+
+    compiled_expression(compiled_expression&& rhs) = delete;
+    compiled_expression(compiled_expression const& rhs) = delete;
+
+    compiled_expression& operator=(compiled_expression&& rhs) = delete;
+    compiled_expression& operator=(compiled_expression const& rhs) = delete;
+
+    ~compiled_expression() = default;
+
+    /**
+     * Gets the text of the expression.
+     *
+     * @return Expression the compiled expression is built from
+     */
+    [[nodiscard]] std::string_view text() const noexcept {
+        return text_;
+    }
+
+    /**
+     * Gets the evaluation mode used for logical operations.
+     *
+     * @return Evaluation mode
+     */
+    [[nodiscard]] tree::evaluation_mode mode() const noexcept {
+        return result_visitor_.mode();
+    }
+
+    /**
+     * Gets the strategy used for evaluation of the expression.
+     *
+     * @return Evaluation strategy
+     */
+    [[nodiscard]] tree::evaluation_strategy strategy() const noexcept {
+        return strategy_;
+    }
+
+    /**
+     * Checks whether the evaluations of the expression's operations are counted.
+     *
+     * @return True if profiling is enabled, otherwise false
+     */
+    [[nodiscard]] bool profiling() const noexcept {
+        return nullptr != profiler_;
+    }
+
+    /**
+     * Gets the statistics collected for the logical and relational operations of
+     * the expression so far, in the order of their positions in the expression text.
+     *
+     * @return Statistics of the operations (empty if profiling is disabled)
+     */
+    [[nodiscard]] std::vector<tree::node_statistics> profile() const {
+        if (nullptr == profiler_) {
+            return {};
+        }
+        return profiler_->report(expression_tree_, text_);
+    }
+
+    /**
+     * Gets the number of objects evaluated since the expression was compiled
+     * or its profile was reset.
+     *
+     * @return Number of profiled evaluations (zero if profiling is disabled)
+     */
+    [[nodiscard]] uint64_t profiled_evaluations() const noexcept {
+        if (nullptr == profiler_) {
+            return 0;
+        }
+        return profiler_->statistics(expression_tree_.index_of(*expression_tree_.root())).evaluations;
+    }
+
+    /**
+     * Resets the statistics collected for the operations of the expression.
+     */
+    void reset_profile() const noexcept {
+        if (nullptr != profiler_) {
+            profiler_->reset();
+        }
+    }
+
+    /**
+     * Compiles the expression again with the operands of its AND and OR operations
+     * reordered by the statistics profiled so far (see tree::reorder_operands), so
+     * the operands which decide the result at the lowest cost are evaluated first.
+     * Results of the evaluations stay the same, only the order in which the fields'
+     * member functions are called changes. The reordered expression is profiled
+     * from scratch, so it can be reordered again later.
+     *
+     * @return Reordered expression or null pointer if profiling is disabled,
+     *         the evaluation mode is eager or the order of the operands stays the same
+     */
+    [[nodiscard]] std::unique_ptr<compiled_expression const> reordered() const {
+        if (nullptr == profiler_ || tree::evaluation_mode::short_circuit != mode()) {
+            return nullptr;
+        }
+
+        // Operands are reordered in a copy first, so nothing is compiled unless the order changes
+        auto arrangement = expression_tree_;
+        if (!tree::reorder_operands(arrangement, *profiler_)) {
+            return nullptr;
+        }
+
+        return std::unique_ptr<compiled_expression const>(new compiled_expression(*this, arrangement));
+    }
+
+    /**
+     * Evaluates expression tree for the object passed in.
+     *
+     * @param obj Object to be evaluated
+     *
+     * @return True if the object's members satisfy the expression, otherwise false
+     */
+    template <typename T>
+    [[nodiscard]] bool evaluate(T const& obj) const {
+        auto const run_program =
+            tree::evaluation_strategy::bytecode == strategy_ &&
+            tree::evaluation_mode::short_circuit == result_visitor_.mode();
+
+        if (run_program) {
+            return result_visitor_.run(program_, obj);
+        } else {
+            return result_visitor_.visit(expression_tree_, *expression_tree_.root(), obj);
+        }
+    }
+
+    /**
+     * Evaluates expression tree for the contiguous sequence of objects.
+     * The tree is traversed once per 64 objects rather than once per object.
+     *
+     * @param objects Pointer to the first object to be evaluated
+     * @param count   Number of objects
+     * @param result  Bitmap with i-th bit set if i-th object satisfies the expression
+     */
+    template <typename T>
+    void evaluate_batch(T const* objects, std::size_t const count, utils::bitmap& result) const {
+        std::array<T const*, utils::bitmap::bits_per_word> batch;
+        evaluate_batches(count, result, [&](std::size_t const offset, std::size_t const size) {
+            for (std::size_t i = 0; i < size; ++i) {
+                batch[i] = objects + offset + i;
+            }
+            return evaluate_chunk(batch.data(), utils::selection::first(size));
+        });
+    }
+
+    /**
+     * Evaluates expression tree for the objects pointed to. Bits of null pointers are never set.
+     *
+     * @param objects Pointer to the first pointer to the object to be evaluated
+     * @param count   Number of objects
+     * @param result  Bitmap with i-th bit set if i-th object satisfies the expression
+     */
+    template <typename T>
+    void evaluate_batch(T const* const* objects, std::size_t const count, utils::bitmap& result) const {
+        evaluate_batches(count, result, [&](std::size_t const offset, std::size_t const size) {
+            uint64_t valid{ 0 };
+            for (std::size_t i = 0; i < size; ++i) {
+                valid |= uint64_t{ nullptr != objects[offset + i] } << i;
+            }
+            return evaluate_chunk(objects + offset, utils::selection(valid));
+        });
+    }
+
+    /**
+     * Evaluates expression tree for the range of objects.
+     *
+     * @param first  Iterator to the first object to be evaluated
+     * @param last   Iterator past the last object to be evaluated
+     * @param result Bitmap with i-th bit set if i-th object satisfies the expression
+     */
+    template <typename Iterator>
+    void evaluate_batch(Iterator first, Iterator last, utils::bitmap& result) const {
+        using T = typename std::iterator_traits<Iterator>::value_type;
+
+        std::array<T const*, utils::bitmap::bits_per_word> batch;
+        auto const count = static_cast<std::size_t>(std::distance(first, last));
+        evaluate_batches(count, result, [&](std::size_t, std::size_t const size) {
+            for (std::size_t i = 0; i < size; ++i, ++first) {
+                batch[i] = std::addressof(*first);
+            }
+            return evaluate_chunk(batch.data(), utils::selection::first(size));
+        });
+    }
+
+    /**
+     * Evaluates expression tree for the contiguous sequence of objects in parallel.
+     * Objects are split into chunks of whole 64-object words, which are evaluated
+     * by the threads of the pool in batches, so each thread writes into disjoint
+     * words of the result.
+     *
+     * @param objects Pointer to the first object to be evaluated
+     * @param count   Number of objects
+     * @param result  Bitmap with i-th bit set if i-th object satisfies the expression
+     * @param pool    Thread pool evaluating the chunks
+     * @param chunk   Number of objects per chunk (rounded up to a multiple of 64)
+     */
+    template <typename T>
+    void evaluate_parallel(T const* objects,
+                           std::size_t const count,
+                           utils::bitmap& result,
+                           utils::thread_pool& pool,
+                           std::size_t const chunk = objects_per_chunk) const {
+        constexpr auto bits_per_word = utils::bitmap::bits_per_word;
+
+        result.resize(count);
+
+        auto const words_per_chunk = std::max<std::size_t>(1, (chunk + bits_per_word - 1) / bits_per_word);
+        auto const words  = result.words();
+        auto const chunks = (words + words_per_chunk - 1) / words_per_chunk;
+
+        pool.parallel_for(chunks, [&](std::size_t const index) {
+            std::array<T const*, bits_per_word> batch;
+
+            auto const first = index * words_per_chunk;
+            auto const last  = std::min(words, first + words_per_chunk);
+            for (auto word = first; word < last; ++word) {
+                auto const offset = word * bits_per_word;
+                auto const size   = std::min(count - offset, bits_per_word);
+                for (std::size_t i = 0; i < size; ++i) {
+                    batch[i] = objects + offset + i;
+                }
+                result.word(word, evaluate_chunk(batch.data(), utils::selection::first(size)));
+            }
+        });
+    }
+
+    /**
+     * Evaluates expression tree for all the rows of the columns. Each field the
+     * expression refers to is read from the column of the same name instead of
+     * calling its member function, so no objects need to be built.
+     *
+     * @param columns Field name - column map
+     * @param result  Bitmap with i-th bit set if i-th row satisfies the expression
+     *
+     * @throws field_not_found if the expression refers to a field without the column
+     * @throws column_size_mismatch if the columns differ in size
+     */
+    void evaluate_columns(column_map const& columns, utils::bitmap& result) const {
+        column_visitor_.visit(expression_tree_, columns, result);
+    }
+
+private:
+    /**
+     * Compiles the expression of the profiled expression again, with the operands
+     * arranged as in the reordered tree.
+     *
+     * @param profiled    Profiled expression
+     * @param arrangement Tree of the profiled expression with the operands reordered
+     */
+    compiled_expression(compiled_expression const& profiled, tree::expression_tree const& arrangement)
+        : text_(profiled.text_),
+          strategy_(profiled.strategy_),
+          result_visitor_(profiled.result_visitor_),
+          column_visitor_(profiled.column_visitor_) {
+        if (!expression_tree_.build(text_)) {
+            throw invalid_expression(text_);
+        }
+
+        // Same text is always built into the same nodes
+        for (tree::node_index i = 0; i < arrangement.nodes().size(); ++i) {
+            expression_tree_.node(i).left  = arrangement.node(i).left;
+            expression_tree_.node(i).right = arrangement.node(i).right;
+        }
+
+        profiler_ = std::make_unique<tree::node_profiler>(expression_tree_.nodes().size());
+        result_visitor_.profiler(profiler_.get());
+
+        result_visitor_.resolve(expression_tree_, *expression_tree_.root());
+        program_.compile(expression_tree_, nullptr != profiler_);
+    }
+
+    /**
+     * Splits the objects into batches of 64 objects and stores the result of each batch.
+     *
+     * @param count  Number of objects
+     * @param result Bitmap with i-th bit set if i-th object satisfies the expression
+     * @param chunk  Function evaluating the batch of objects at the specified offset
+     */
+    template <typename F>
+    void evaluate_batches(std::size_t const count, utils::bitmap& result, F&& chunk) const {
+        result.resize(count);
+
+        for (std::size_t offset = 0; offset < count; offset += utils::bitmap::bits_per_word) {
+            auto const size = std::min(count - offset, utils::bitmap::bits_per_word);
+            result.word(offset / utils::bitmap::bits_per_word, chunk(offset, size));
+        }
+    }
+
+    /**
+     * Evaluates expression tree for the batch of (up to 64) objects.
+     *
+     * @param objects Pointers to objects to be evaluated
+     * @param rows    Selection of the objects to be evaluated
+     *
+     * @return Bitmask with i-th bit set if i-th object is selected and satisfies the expression
+     */
+    template <typename T>
+    [[nodiscard]] uint64_t evaluate_chunk(T const* const* objects, utils::selection const rows) const {
+        return result_visitor_.visit_batch(expression_tree_, *expression_tree_.root(), objects, rows);
+    }
+
+private:
+    std::string const text_;
+    tree::evaluation_strategy const strategy_;
+    tree::result_visitor<MemFn> result_visitor_;
+    tree::column_visitor column_visitor_;
+    tree::expression_tree expression_tree_;
+    tree::program program_;
+    std::unique_ptr<tree::node_profiler> profiler_;
+};
+
+} // booleval
+
+#endif // BOOLEVAL_COMPILED_EXPRESSION_H
\ No newline at end of file
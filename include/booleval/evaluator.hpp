@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Marin Peko
+ * Copyright (c) 2020, Marin Peko
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -31,8 +31,17 @@
 #define BOOLEVAL_EVALUATOR_H
 
 #include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <iterator>
 #include <string_view>
+#include <booleval/exceptions.hpp>
+#include <booleval/compiled_expression.hpp>
+#include <booleval/tree/column_visitor.hpp>
+#include <booleval/utils/bitmap.hpp>
 #include <booleval/utils/any_mem_fn.hpp>
+#include <booleval/utils/thread_pool.hpp>
 #include <booleval/tree/result_visitor.hpp>
 #include <booleval/tree/expression_tree.hpp>
 
@@ -42,20 +51,36 @@ namespace booleval {
  * class evaluator
  *
  * Represents a class for evaluating logical expressions in a form of a string.
- * It builds an expression tree and traverses that tree in order to evaluate fields.
+ * It builds an expression tree and either traverses that tree or executes the
+ * program compiled from it in order to evaluate fields.
+ *
+ * The expression is held as an immutable compiled expression, which is replaced
+ * whenever the expression, fields, mode, strategy or profiling change. Copies
+ * of the evaluator share the compiled expression, and the compiled expression
+ * itself can be shared with other threads, instead of copying the whole evaluator.
+ * Evaluator itself must not be reconfigured while other threads evaluate
+ * through it; expression_holder supports replacing the expression live.
+ *
+ * With profiling enabled, the evaluator can be adapted to the objects being
+ * evaluated by periodically calling adapt, which reorders the operands of AND
+ * and OR operations by their observed selectivity and cost.
  */
 template <typename MemFn = utils::any_mem_fn>
 class evaluator {
     using field_map = std::map<std::string_view, MemFn>;
+    using column_map = tree::column_visitor::column_map;
 
 public:
+    static constexpr std::size_t objects_per_chunk{ compiled_expression<MemFn>::objects_per_chunk };
+    static constexpr uint64_t adaptation_period{ compiled_expression<MemFn>::adaptation_period };
+
     evaluator() = default;
     evaluator(evaluator&& rhs) = default;
     evaluator(evaluator const& rhs) = default;
 
-    evaluator(field_map const& fields) {
-        result_visitor_.fields(fields);
-    }
+    evaluator(field_map const& fields)
+        : fields_(fields)
+    {}
 
     evaluator& operator=(evaluator&& rhs) = default;
     evaluator& operator=(evaluator const& rhs) = default;
@@ -64,11 +89,115 @@ public:
 
     /**
      * Sets the key - member function map used for evaluation of expression tree.
+     * If the expression is already set, its fields are linked to the new map.
      *
      * @param fields Key - member function map
+     *
+     * @throws field_not_found if the expression refers to a field missing from the map
+     */
+    void fields(field_map const& fields) {
+        fields_ = fields;
+        recompile();
+    }
+
+    /**
+     * Sets the evaluation mode used for logical operations. Short-circuit
+     * evaluation is used by default.
+     *
+     * @param mode Evaluation mode
+     */
+    void mode(tree::evaluation_mode const mode) {
+        mode_ = mode;
+        recompile();
+    }
+
+    /**
+     * Gets the evaluation mode used for logical operations.
+     *
+     * @return Evaluation mode
+     */
+    [[nodiscard]] tree::evaluation_mode mode() const noexcept {
+        return mode_;
+    }
+
+    /**
+     * Sets the strategy used for evaluation of the expression. Expression tree
+     * is walked by default. Compiled program is only executed in short-circuit
+     * mode, while eager evaluation always walks the expression tree.
+     *
+     * @param strategy Evaluation strategy
+     */
+    void strategy(tree::evaluation_strategy const strategy) {
+        strategy_ = strategy;
+        recompile();
+    }
+
+    /**
+     * Gets the strategy used for evaluation of the expression.
+     *
+     * @return Evaluation strategy
+     */
+    [[nodiscard]] tree::evaluation_strategy strategy() const noexcept {
+        return strategy_;
+    }
+
+    /**
+     * Enables or disables counting of the evaluations of each operation of the
+     * expression. Profiling is disabled by default. Changing it starts profiling
+     * the expression from scratch.
+     *
+     * @param profiling Whether the evaluations are counted
+     */
+    void profiling(bool const profiling) {
+        profiling_ = profiling;
+        recompile();
+    }
+
+    /**
+     * Checks whether the evaluations of the expression's operations are counted.
+     *
+     * @return True if profiling is enabled, otherwise false
+     */
+    [[nodiscard]] bool profiling() const noexcept {
+        return profiling_;
+    }
+
+    /**
+     * Gets the statistics collected for the logical and relational operations of
+     * the expression, in the order of their positions in the expression text.
+     *
+     * @return Statistics of the operations (empty if profiling is disabled
+     *         or the evaluation is not activated)
+     */
+    [[nodiscard]] std::vector<tree::node_statistics> profile() const {
+        return nullptr != compiled_ ? compiled_->profile() : std::vector<tree::node_statistics>{};
+    }
+
+    /**
+     * Reorders the operands of the expression's AND and OR operations by the
+     * statistics profiled since the last adaptation, if enough objects have been
+     * evaluated in the meantime (see compiled_expression::reordered). If the order
+     * stays the same, the statistics are profiled from scratch. Results of the
+     * evaluations do not change. It should be called periodically while evaluating
+     * objects, and it has no effect unless profiling is enabled.
+     *
+     * @param min_evaluations Minimum number of objects evaluated since the last adaptation
+     *
+     * @return True if the operands are reordered, otherwise false
      */
-    void fields(field_map const& fields) noexcept {
-        result_visitor_.fields(fields);
+    [[nodiscard]] bool adapt(uint64_t const min_evaluations = adaptation_period) {
+        if (nullptr == compiled_ || compiled_->profiled_evaluations() < min_evaluations) {
+            return false;
+        }
+
+        auto reordered = compiled_->reordered();
+        if (nullptr == reordered) {
+            compiled_->reset_profile();
+            return false;
+        }
+
+        compiled_ = std::move(reordered);
+        return true;
     }
 
     /**
@@ -78,18 +207,31 @@ public:
      * @return True if the evaluation is activated, otherwise false
      */
     [[nodiscard]] bool is_activated() const noexcept {
-        return is_activated_;
+        return nullptr != compiled_;
     }
 
     /**
-     * Sets the expression to be used for evaluation.
+     * Sets the expression to be used for evaluation. The expression is copied,
+     * so it does not need to outlive the evaluator.
      *
      * @param expression Expression to be used for evaluation
      *
      * @return True if the expression is valid, otherwise false
+     *
+     * @throws field_not_found if the expression refers to a field that does not exist
      */
     [[nodiscard]] bool expression(std::string_view expression);
 
+    /**
+     * Gets the compiled expression, which can be shared with other threads
+     * and evaluated concurrently without locking.
+     *
+     * @return Compiled expression or null pointer if the evaluation is not activated
+     */
+    [[nodiscard]] std::shared_ptr<compiled_expression<MemFn> const> compiled() const noexcept {
+        return compiled_;
+    }
+
     /**
      * Evaluates expression tree for the object passed in.
      *
@@ -98,33 +240,140 @@ public:
      * @return True if the object's members satisfy the expression, otherwise false
      */
     template <typename T>
-    [[nodiscard]] bool evaluate(T const& obj) {
-        if (is_activated_) {
-            return result_visitor_.visit(*expression_tree_.root(), obj);
+    [[nodiscard]] bool evaluate(T const& obj) const {
+        return nullptr != compiled_ && compiled_->evaluate(obj);
+    }
+
+    /**
+     * Evaluates expression tree for the contiguous sequence of objects.
+     * The tree is traversed once per 64 objects rather than once per object.
+     *
+     * @param objects Pointer to the first object to be evaluated
+     * @param count   Number of objects
+     * @param result  Bitmap with i-th bit set if i-th object satisfies the expression
+     */
+    template <typename T>
+    void evaluate_batch(T const* objects, std::size_t const count, utils::bitmap& result) const {
+        if (nullptr != compiled_) {
+            compiled_->evaluate_batch(objects, count, result);
         } else {
-            return false;
+            result.resize(count);
+        }
+    }
+
+    /**
+     * Evaluates expression tree for the objects pointed to. Bits of null pointers are never set.
+     *
+     * @param objects Pointer to the first pointer to the object to be evaluated
+     * @param count   Number of objects
+     * @param result  Bitmap with i-th bit set if i-th object satisfies the expression
+     */
+    template <typename T>
+    void evaluate_batch(T const* const* objects, std::size_t const count, utils::bitmap& result) const {
+        if (nullptr != compiled_) {
+            compiled_->evaluate_batch(objects, count, result);
+        } else {
+            result.resize(count);
+        }
+    }
+
+    /**
+     * Evaluates expression tree for the range of objects.
+     *
+     * @param first  Iterator to the first object to be evaluated
+     * @param last   Iterator past the last object to be evaluated
+     * @param result Bitmap with i-th bit set if i-th object satisfies the expression
+     */
+    template <typename Iterator>
+    void evaluate_batch(Iterator first, Iterator last, utils::bitmap& result) const {
+        if (nullptr != compiled_) {
+            compiled_->evaluate_batch(first, last, result);
+        } else {
+            result.resize(static_cast<std::size_t>(std::distance(first, last)));
+        }
+    }
+
+    /**
+     * Evaluates expression tree for the contiguous sequence of objects in parallel.
+     * Objects are split into chunks of whole 64-object words, which are evaluated
+     * by the threads of the pool in batches, so each thread writes into disjoint
+     * words of the result.
+     *
+     * @param objects Pointer to the first object to be evaluated
+     * @param count   Number of objects
+     * @param result  Bitmap with i-th bit set if i-th object satisfies the expression
+     * @param pool    Thread pool evaluating the chunks
+     * @param chunk   Number of objects per chunk (rounded up to a multiple of 64)
+     */
+    template <typename T>
+    void evaluate_parallel(T const* objects,
+                           std::size_t const count,
+                           utils::bitmap& result,
+                           utils::thread_pool& pool,
+                           std::size_t const chunk = objects_per_chunk) const {
+        if (nullptr != compiled_) {
+            compiled_->evaluate_parallel(objects, count, result, pool, chunk);
+        } else {
+            result.resize(count);
+        }
+    }
+
+    /**
+     * Evaluates expression tree for all the rows of the columns. Each field the
+     * expression refers to is read from the column of the same name instead of
+     * calling its member function, so no objects need to be built.
+     *
+     * @param columns Field name - column map
+     * @param result  Bitmap with i-th bit set if i-th row satisfies the expression
+     *
+     * @throws field_not_found if the expression refers to a field without the column
+     * @throws column_size_mismatch if the columns differ in size
+     */
+    void evaluate_columns(column_map const& columns, utils::bitmap& result) const {
+        if (nullptr != compiled_) {
+            compiled_->evaluate_columns(columns, result);
+        } else {
+            tree::column_visitor{}.visit(tree::expression_tree{}, columns, result);
+        }
+    }
+
+private:
+    /**
+     * Compiles the current expression again, so it reflects the current
+     * fields, mode, strategy and profiling. Evaluation is deactivated if it fails.
+     *
+     * @throws field_not_found if the expression refers to a field that does not exist
+     */
+    void recompile() {
+        if (nullptr != compiled_) {
+            auto const previous = std::move(compiled_);
+            compiled_ = std::make_shared<compiled_expression<MemFn> const>(previous->text(), fields_, mode_, strategy_, profiling_);
         }
     }
 
 private:
-    bool is_activated_{ false };
-    tree::result_visitor<MemFn> result_visitor_;
-    tree::expression_tree expression_tree_;
+    field_map fields_;
+    tree::evaluation_mode mode_{ tree::evaluation_mode::short_circuit };
+    tree::evaluation_strategy strategy_{ tree::evaluation_strategy::tree_walk };
+    bool profiling_{ false };
+    std::shared_ptr<compiled_expression<MemFn> const> compiled_;
 };
 
 template<typename MemFn>
 bool evaluator<MemFn>::expression(std::string_view expression) {
-    is_activated_ = false;
+    compiled_.reset();
 
     if (expression.empty()) {
         return true;
     }
 
-    if (expression_tree_.build(expression)) {
-        is_activated_ = true;
+    try {
+        compiled_ = std::make_shared<compiled_expression<MemFn> const>(expression, fields_, mode_, strategy_, profiling_);
+    } catch (invalid_expression const&) {
+        return false;
     }
 
-    return is_activated_;
+    return true;
 }
 
 } // booleval
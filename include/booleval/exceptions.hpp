@@ -77,6 +77,51 @@ struct field_not_found : base_exception {
     {}
 };
 
+/**
+ * struct invalid_expression
+ *
+ * Exception thrown when an expression cannot be compiled.
+ */
+struct invalid_expression : base_exception {
+    invalid_expression()
+        : base_exception("Invalid expression")
+    {}
+
+    invalid_expression(std::string_view expression)
+        : base_exception("Invalid expression '" + std::string(expression) + "'")
+    {}
+};
+
+/**
+ * struct column_size_mismatch
+ *
+ * Exception thrown when columns evaluated together differ in size.
+ */
+struct column_size_mismatch : base_exception {
+    column_size_mismatch()
+        : base_exception("Column size mismatch")
+    {}
+
+    column_size_mismatch(std::string_view field)
+        : base_exception("Column '" + std::string(field) + "' size mismatch")
+    {}
+};
+
+/**
+ * struct too_many_readers
+ *
+ * Exception thrown when no more readers can be registered.
+ */
+struct too_many_readers : base_exception {
+    too_many_readers()
+        : base_exception("Too many readers")
+    {}
+
+    too_many_readers(std::size_t const limit)
+        : base_exception("Too many readers (limit is " + std::to_string(limit) + ")")
+    {}
+};
+
 } // booleval
 
 #endif // BOOLEVAL_EXCEPTIONS_H
\ No newline at end of file
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_EXPRESSION_CACHE_H
+#define BOOLEVAL_EXPRESSION_CACHE_H
+
+#include <map>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <booleval/exceptions.hpp>
+#include <booleval/compiled_expression.hpp>
+#include <booleval/token/tokenizer.hpp>
+#include <booleval/utils/any_mem_fn.hpp>
+
+namespace booleval {
+
+/**
+ * struct cache_statistics
+ *
+ * Represents the counters of the expression cache.
+ */
+struct cache_statistics {
+    uint64_t hits{ 0 };
+    uint64_t misses{ 0 };
+    uint64_t evictions{ 0 };
+    std::size_t size{ 0 };
+    std::size_t capacity{ 0 };
+};
+
+/**
+ * class expression_cache
+ *
+ * Represents a bounded cache of compiled expressions, shared by all the threads.
+ * Expressions are looked up by the canonical form of their tokens, so expressions
+ * differing only in whitespace, spelling of operators or quoting of fields share
+ * the same compiled expression. A hit only costs tokenizing the expression, while
+ * a miss compiles it outside of the lock. When the cache is full, the least
+ * recently used expression is evicted; evicted expressions stay alive for as long
+ * as someone holds them.
+ */
+template <typename MemFn = utils::any_mem_fn>
+class expression_cache {
+    using field_map = std::map<std::string_view, MemFn>;
+
+public:
+    using compiled_type = compiled_expression<MemFn>;
+    using compiled_ptr  = std::shared_ptr<compiled_type const>;
+
+    static constexpr std::size_t default_capacity{ 1024 };
+
+    /**
+     * Creates the empty cache.
+     *
+     * @param fields   Key - member function map
+     * @param capacity Maximum number of cached expressions
+     * @param mode     Evaluation mode used for logical operations
+     * @param strategy Strategy used for evaluation of the expressions
+     */
+    explicit expression_cache(field_map const& fields,
+                              std::size_t const capacity = default_capacity,
+                              tree::evaluation_mode const mode = tree::evaluation_mode::short_circuit,
+                              tree::evaluation_strategy const strategy = tree::evaluation_strategy::tree_walk)
+        : fields_(fields),
+          capacity_(capacity),
+          mode_(mode),
+          strategy_(strategy)
+    {}
+
+    expression_cache(expression_cache&& rhs) = delete;
+    expression_cache(expression_cache const& rhs) = delete;
+
+    expression_cache& operator=(expression_cache&& rhs) = delete;
+    expression_cache& operator=(expression_cache const& rhs) = delete;
+
+    ~expression_cache() = default;
+
+    /**
+     * Gets the compiled expression, compiling and caching it if it is not cached yet.
+     *
+     * @param expression Expression to be compiled
+     *
+     * @return Compiled expression or null pointer if the expression is empty or not valid
+     *
+     * @throws field_not_found if the expression refers to a field that does not exist
+     */
+    [[nodiscard]] compiled_ptr get(std::string_view expression);
+
+    /**
+     * Gets the counters of the cache.
+     *
+     * @return Number of hits, misses and evictions, and the current size of the cache
+     */
+    [[nodiscard]] cache_statistics statistics() const {
+        cache_statistics statistics;
+        statistics.hits      = hits_.load(std::memory_order_relaxed);
+        statistics.misses    = misses_.load(std::memory_order_relaxed);
+        statistics.evictions = evictions_.load(std::memory_order_relaxed);
+        statistics.size      = size();
+        statistics.capacity  = capacity_;
+        return statistics;
+    }
+
+    /**
+     * Gets the number of cached expressions.
+     *
+     * @return Number of cached expressions
+     */
+    [[nodiscard]] std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    /**
+     * Removes all the cached expressions. Counters are kept.
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index_.clear();
+        entries_.clear();
+    }
+
+private:
+    /**
+     * struct entry
+     *
+     * Represents the cached expression. Entries are ordered from the most
+     * to the least recently used one.
+     */
+    struct entry {
+        std::string key;
+        compiled_ptr compiled;
+    };
+
+    using entry_list = std::list<entry>;
+
+private:
+    field_map const fields_;
+    std::size_t const capacity_;
+    tree::evaluation_mode const mode_;
+    tree::evaluation_strategy const strategy_;
+
+    mutable std::mutex mutex_;
+    entry_list entries_;
+    std::unordered_map<std::string_view, typename entry_list::iterator> index_;
+
+    std::atomic<uint64_t> hits_{ 0 };
+    std::atomic<uint64_t> misses_{ 0 };
+    std::atomic<uint64_t> evictions_{ 0 };
+};
+
+template <typename MemFn>
+typename expression_cache<MemFn>::compiled_ptr expression_cache<MemFn>::get(std::string_view expression) {
+    token::tokenizer tokenizer(expression);
+    tokenizer.tokenize();
+
+    auto key = tokenizer.canonical_form();
+    if (key.empty()) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto const iter = index_.find(key);
+        if (iter != std::end(index_)) {
+            entries_.splice(std::begin(entries_), entries_, iter->second);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return iter->second->compiled;
+        }
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+
+    compiled_ptr compiled;
+    try {
+        compiled = std::make_shared<compiled_type const>(expression, fields_, mode_, strategy_);
+    } catch (invalid_expression const&) {
+        return nullptr;
+    }
+
+    if (0 == capacity_) {
+        return compiled;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Another thread might have compiled the same expression in the meantime
+    auto const iter = index_.find(key);
+    if (iter != std::end(index_)) {
+        entries_.splice(std::begin(entries_), entries_, iter->second);
+        return iter->second->compiled;
+    }
+
+    entries_.push_front({ std::move(key), compiled });
+    index_.emplace(entries_.front().key, std::begin(entries_));
+
+    if (entries_.size() > capacity_) {
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return compiled;
+}
+
+} // booleval
+
+#endif // BOOLEVAL_EXPRESSION_CACHE_H
\ No newline at end of file
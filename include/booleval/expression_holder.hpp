@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_EXPRESSION_HOLDER_H
+#define BOOLEVAL_EXPRESSION_HOLDER_H
+
+#include <map>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <cstdint>
+#include <string_view>
+#include <booleval/exceptions.hpp>
+#include <booleval/compiled_expression.hpp>
+#include <booleval/utils/epoch.hpp>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/utils/any_mem_fn.hpp>
+
+namespace booleval {
+
+/**
+ * class expression_holder
+ *
+ * Represents the active expression which can be replaced while other threads
+ * are evaluating it. A new expression is compiled off to the side and then
+ * published by atomically swapping the pointer to the compiled expression.
+ * Threads evaluate the expression through their own readers, which never
+ * block or take locks, while the replaced expression is destroyed by the
+ * epoch-based reclamation once no reader can hold it anymore.
+ *
+ * Adaptive holder profiles the active expression, and periodically calling
+ * adapt publishes it again with the operands of AND and OR operations
+ * reordered by their observed selectivity and cost.
+ */
+template <typename MemFn = utils::any_mem_fn>
+class expression_holder {
+    using field_map = std::map<std::string_view, MemFn>;
+    using compiled_type = compiled_expression<MemFn>;
+
+public:
+    class reader;
+
+    /**
+     * class guard
+     *
+     * Represents the critical section of a reader. Compiled expression
+     * obtained through the guard stays alive until the guard is destroyed.
+     */
+    class guard {
+    public:
+        guard(guard&& rhs) = delete;
+        guard(guard const& rhs) = delete;
+
+        guard& operator=(guard&& rhs) = delete;
+        guard& operator=(guard const& rhs) = delete;
+
+        ~guard() {
+            reader_.leave();
+        }
+
+        /**
+         * Gets the compiled expression active when the guard was created.
+         *
+         * @return Compiled expression or null pointer if no expression is active
+         */
+        [[nodiscard]] compiled_type const* get() const noexcept {
+            return compiled_;
+        }
+
+        [[nodiscard]] compiled_type const* operator->() const noexcept {
+            return compiled_;
+        }
+
+        [[nodiscard]] explicit operator bool() const noexcept {
+            return nullptr != compiled_;
+        }
+
+    private:
+        friend class reader;
+
+        explicit guard(reader& owner)
+            : reader_(owner),
+              compiled_(owner.enter())
+        {}
+
+    private:
+        reader& reader_;
+        compiled_type const* compiled_;
+    };
+
+    /**
+     * class reader
+     *
+     * Represents a thread's handle for evaluating the active expression.
+     * Each thread needs its own reader, since the reader is not thread-safe.
+     */
+    class reader {
+    public:
+        /**
+         * Moves the reader's slot. Guards refer to the reader they are created by,
+         * so the reader cannot be moved while any of its guards is alive.
+         *
+         * @param rhs Reader without any guard alive
+         */
+        reader(reader&& rhs) noexcept
+            : holder_(rhs.holder_),
+              slot_(rhs.slot_)
+        {
+            assert(0 == rhs.depth_ && "Reader cannot be moved while it is pinned");
+            rhs.holder_ = nullptr;
+        }
+
+        reader(reader const& rhs) = delete;
+
+        reader& operator=(reader&& rhs) = delete;
+        reader& operator=(reader const& rhs) = delete;
+
+        ~reader() {
+            if (nullptr != holder_) {
+                holder_->domain_.release_slot(slot_);
+            }
+        }
+
+        /**
+         * Starts the critical section and gets the active expression.
+         * Critical sections of the same reader can be nested.
+         *
+         * @return Guard holding the active expression
+         */
+        [[nodiscard]] guard pin() {
+            return guard(*this);
+        }
+
+        /**
+         * Evaluates the active expression for the object passed in.
+         *
+         * @param obj Object to be evaluated
+         *
+         * @return True if the object's members satisfy the expression, otherwise false
+         */
+        template <typename T>
+        [[nodiscard]] bool evaluate(T const& obj) {
+            auto const active = pin();
+            return active && active->evaluate(obj);
+        }
+
+        /**
+         * Evaluates the active expression for the contiguous sequence of objects.
+         * All the objects are evaluated by the same expression, even if another
+         * one is published in the meantime.
+         *
+         * @param objects Pointer to the first object to be evaluated
+         * @param count   Number of objects
+         * @param result  Bitmap with i-th bit set if i-th object satisfies the expression
+         */
+        template <typename T>
+        void evaluate_batch(T const* objects, std::size_t const count, utils::bitmap& result) {
+            auto const active = pin();
+            if (active) {
+                active->evaluate_batch(objects, count, result);
+            } else {
+                result.resize(count);
+            }
+        }
+
+    private:
+        friend class expression_holder;
+        friend class guard;
+
+        explicit reader(expression_holder& holder)
+            : holder_(&holder),
+              slot_(holder.domain_.acquire_slot())
+        {}
+
+        [[nodiscard]] compiled_type const* enter() noexcept {
+            if (0 == depth_++) {
+                holder_->domain_.enter(slot_);
+            }
+            return holder_->active_.load();
+        }
+
+        void leave() noexcept {
+            if (0 == --depth_) {
+                holder_->domain_.leave(slot_);
+            }
+        }
+
+    private:
+        expression_holder* holder_;
+        std::size_t slot_;
+        std::size_t depth_{ 0 };
+    };
+
+    /**
+     * Creates the holder without an active expression.
+     *
+     * @param fields      Key - member function map
+     * @param mode        Evaluation mode used for logical operations
+     * @param strategy    Strategy used for evaluation of the expression
+     * @param max_readers Maximum number of readers registered at the same time
+     * @param adaptive    Whether the published expressions are profiled in order to be adapted
+     */
+    explicit expression_holder(field_map const& fields,
+                               tree::evaluation_mode const mode = tree::evaluation_mode::short_circuit,
+                               tree::evaluation_strategy const strategy = tree::evaluation_strategy::tree_walk,
+                               std::size_t const max_readers = utils::epoch_domain::default_readers,
+                               bool const adaptive = false)
+        : fields_(fields),
+          mode_(mode),
+          strategy_(strategy),
+          adaptive_(adaptive),
+          domain_(max_readers)
+    {}
+
+    expression_holder(expression_holder&& rhs) = delete;
+    expression_holder(expression_holder const& rhs) = delete;
+
+    expression_holder& operator=(expression_holder&& rhs) = delete;
+    expression_holder& operator=(expression_holder const& rhs) = delete;
+
+    /**
+     * Destroys the active expression. All the readers must be destroyed first.
+     */
+    ~expression_holder() {
+        delete active_.load();
+    }
+
+    /**
+     * Registers a reader for the calling thread.
+     *
+     * @return Reader of the active expression
+     *
+     * @throws too_many_readers if the maximum number of readers is reached
+     */
+    [[nodiscard]] reader make_reader() {
+        return reader(*this);
+    }
+
+    /**
+     * Compiles the expression and makes it the active one. Readers which already
+     * hold the previous expression keep evaluating it until their guards end.
+     * If the expression is not valid, the active expression is kept.
+     * Empty expression deactivates the evaluation.
+     *
+     * @param expression Expression to be published (copied into the compiled expression)
+     *
+     * @return True if the expression is valid and published, otherwise false
+     *
+     * @throws field_not_found if the expression refers to a field that does not exist
+     */
+    [[nodiscard]] bool publish(std::string_view expression) {
+        std::unique_ptr<compiled_type const> compiled;
+        if (!expression.empty()) {
+            try {
+                compiled = std::make_unique<compiled_type const>(expression, fields_, mode_, strategy_, adaptive_);
+            } catch (invalid_expression const&) {
+                return false;
+            }
+        }
+
+        domain_.retire(active_.exchange(compiled.release()));
+        return true;
+    }
+
+    /**
+     * Publishes the active expression again with the operands of its AND and OR
+     * operations reordered by the statistics profiled since the last adaptation, if
+     * enough objects have been evaluated in the meantime. If the order stays the
+     * same, the statistics are profiled from scratch. Readers keep evaluating
+     * the previous expression until their guards end, and the results of the
+     * evaluations do not change. It should be called periodically by the thread
+     * publishing the expressions, and it has no effect unless the holder is adaptive.
+     * The active expression is read through its own reader, and the reordered one
+     * is dropped if another expression is published in the meantime.
+     *
+     * @param min_evaluations Minimum number of objects evaluated since the last adaptation
+     *
+     * @return True if the reordered expression is published, otherwise false
+     *
+     * @throws too_many_readers if all the reader slots are taken
+     */
+    [[nodiscard]] bool adapt(uint64_t const min_evaluations = compiled_type::adaptation_period) {
+        auto adapter = make_reader();
+
+        compiled_type const* replaced{ nullptr };
+        {
+            auto const active = adapter.pin();
+            if (!active || active->profiled_evaluations() < min_evaluations) {
+                return false;
+            }
+
+            auto reordered = active->reordered();
+            if (nullptr == reordered) {
+                active->reset_profile();
+                return false;
+            }
+
+            replaced = active.get();
+            if (!active_.compare_exchange_strong(replaced, reordered.get())) {
+                return false;
+            }
+            reordered.release();
+        }
+
+        domain_.retire(replaced);
+        return true;
+    }
+
+    /**
+     * Checks whether there is an active expression.
+     *
+     * @return True if an expression is active, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept {
+        return nullptr != active_.load();
+    }
+
+    /**
+     * Destroys the replaced expressions which no reader holds anymore.
+     * It is also done on each publication.
+     *
+     * @return Number of replaced expressions still waiting to be destroyed
+     */
+    std::size_t reclaim() {
+        return domain_.reclaim();
+    }
+
+private:
+    field_map const fields_;
+    tree::evaluation_mode const mode_;
+    tree::evaluation_strategy const strategy_;
+    bool const adaptive_;
+
+    std::atomic<compiled_type const*> active_{ nullptr };
+    utils::epoch_domain domain_;
+};
+
+} // booleval
+
+#endif // BOOLEVAL_EXPRESSION_HOLDER_H
\ No newline at end of file
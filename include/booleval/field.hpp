@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_FIELD_H
+#define BOOLEVAL_FIELD_H
+
+#include <tuple>
+#include <string_view>
+#include <type_traits>
+
+namespace booleval {
+
+/**
+ * struct member_class
+ *
+ * Represents the class a pointer to data member or member function belongs to.
+ */
+template <typename M>
+struct member_class;
+
+template <typename Ret, typename C>
+struct member_class<Ret C::*> {
+    using type = C;
+};
+
+template <typename M>
+using member_class_t = typename member_class<M>::type;
+
+/**
+ * struct field
+ *
+ * Represents a field of the statically typed evaluator, i.e. the name used in
+ * the expressions and the pointer to data member or member function (taking
+ * no arguments) used for getting the field's value.
+ */
+template <typename M>
+struct field {
+    static_assert(std::is_member_pointer_v<M>, "Pointer to data member or member function expected");
+
+    std::string_view name;
+    M member;
+};
+
+template <typename M>
+field(std::string_view, M) -> field<M>;
+
+/**
+ * Creates the compile-time table of fields to be used by the statically typed evaluator.
+ *
+ * @param fields Fields in the table
+ *
+ * @return Table of fields
+ */
+template <typename... M>
+[[nodiscard]] constexpr auto make_fields(field<M> const... fields) noexcept {
+    return std::make_tuple(fields...);
+}
+
+/**
+ * Gets the value of the field for the object passed in.
+ *
+ * @param member Pointer to data member or member function
+ * @param obj    Object to get the value from
+ *
+ * @return Value of the field
+ */
+template <typename M, typename T>
+[[nodiscard]] constexpr decltype(auto) invoke_field(M const member, T const& obj) {
+    static_assert(std::is_base_of_v<member_class_t<M>, T>, "Field does not belong to the object's class");
+
+    if constexpr (std::is_member_function_pointer_v<M>) {
+        // Non-const member functions are supported for convenience and are
+        // expected not to modify the object
+        return (const_cast<T&>(obj).*member)();
+    } else {
+        return (obj.*member);
+    }
+}
+
+} // booleval
+
+#endif // BOOLEVAL_FIELD_H
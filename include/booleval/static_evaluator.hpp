@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_STATIC_EVALUATOR_H
+#define BOOLEVAL_STATIC_EVALUATOR_H
+
+#include <string_view>
+#include <booleval/field.hpp>
+#include <booleval/tree/expression_tree.hpp>
+#include <booleval/tree/static_result_visitor.hpp>
+
+namespace booleval {
+
+/**
+ * class static_evaluator
+ *
+ * Represents a class for evaluating logical expressions in a form of a string
+ * on objects of a single, statically known type. Fields are registered as
+ * a compile-time table of pointers to data members or member functions,
+ * created by booleval::make_fields, so the getters are called directly
+ * and can be inlined by the compiler.
+ *
+ * Example:
+ *
+ *     constexpr auto obj_fields = booleval::make_fields(
+ *         booleval::field{ "field_a", &obj::field_a },
+ *         booleval::field{ "field_b", &obj::field_b_ }
+ *     );
+ *
+ *     booleval::static_evaluator<obj, obj_fields> evaluator;
+ */
+template <typename T, auto const& Fields>
+class static_evaluator {
+public:
+    static_evaluator() = default;
+    static_evaluator(static_evaluator&& rhs) = default;
+    static_evaluator(static_evaluator const& rhs) = default;
+
+    static_evaluator& operator=(static_evaluator&& rhs) = default;
+    static_evaluator& operator=(static_evaluator const& rhs) = default;
+
+    ~static_evaluator() = default;
+
+    /**
+     * Sets the evaluation mode used for logical operations. Short-circuit
+     * evaluation is used by default.
+     *
+     * @param mode Evaluation mode
+     */
+    void mode(tree::evaluation_mode const mode) noexcept {
+        result_visitor_.mode(mode);
+    }
+
+    /**
+     * Gets the evaluation mode used for logical operations.
+     *
+     * @return Evaluation mode
+     */
+    [[nodiscard]] tree::evaluation_mode mode() const noexcept {
+        return result_visitor_.mode();
+    }
+
+    /**
+     * Checks whether the evaluation is activated or not, i.e.
+     * if the expression tree is successfully built.
+     *
+     * @return True if the evaluation is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept {
+        return is_activated_;
+    }
+
+    /**
+     * Sets the expression to be used for evaluation.
+     *
+     * @param expression Expression to be used for evaluation
+     *
+     * @return True if the expression is valid, otherwise false
+     *
+     * @throws field_not_found if the expression refers to a field that does not exist
+     */
+    [[nodiscard]] bool expression(std::string_view expression);
+
+    /**
+     * Evaluates expression tree for the object passed in.
+     *
+     * @param obj Object to be evaluated
+     *
+     * @return True if the object's members satisfy the expression, otherwise false
+     */
+    [[nodiscard]] bool evaluate(T const& obj) const {
+        if (is_activated_) {
+            return result_visitor_.visit(expression_tree_, *expression_tree_.root(), obj);
+        } else {
+            return false;
+        }
+    }
+
+private:
+    bool is_activated_{ false };
+    tree::static_result_visitor<T, Fields> result_visitor_;
+    tree::expression_tree expression_tree_;
+};
+
+template <typename T, auto const& Fields>
+bool static_evaluator<T, Fields>::expression(std::string_view expression) {
+    is_activated_ = false;
+
+    if (expression.empty()) {
+        return true;
+    }
+
+    if (expression_tree_.build(expression)) {
+        result_visitor_.resolve(expression_tree_, *expression_tree_.root());
+        is_activated_ = true;
+    }
+
+    return is_activated_;
+}
+
+} // booleval
+
+#endif // BOOLEVAL_STATIC_EVALUATOR_H
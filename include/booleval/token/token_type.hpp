@@ -31,6 +31,7 @@
 #define BOOLEVAL_TOKEN_TYPE_H
 
 #include <array>
+#include <algorithm>
 #include <cstdint>
 #include <utility>
 #include <string_view>
@@ -67,27 +68,23 @@ enum class [[nodiscard]] token_type : uint8_t {
     rp = 11
 };
 
-constexpr std::size_t count_of_keyword_expressions{ 16 };
+/**
+ * Keywords are matched case-insensitively, so only their lowercase
+ * spelling is listed.
+ */
+constexpr std::size_t count_of_keyword_expressions{ 8 };
 constexpr std::array<
     std::pair<std::string_view, token_type>,
     count_of_keyword_expressions
 > keyword_expressions = {{
     { "and", token_type::logical_and },
-    { "AND", token_type::logical_and },
     { "or",  token_type::logical_or  },
-    { "OR",  token_type::logical_or  },
     { "eq",  token_type::eq  },
-    { "EQ",  token_type::eq  },
     { "neq", token_type::neq },
-    { "NEQ", token_type::neq },
     { "gt",  token_type::gt  },
-    { "GT",  token_type::gt  },
     { "lt",  token_type::lt  },
-    { "LT",  token_type::lt  },
     { "geq", token_type::geq },
-    { "GEQ", token_type::geq },
-    { "leq", token_type::leq },
-    { "LEQ", token_type::leq }
+    { "leq", token_type::leq }
 }};
 
 constexpr std::size_t count_of_symbol_expressions{ 10 };
@@ -133,38 +130,148 @@ constexpr auto parenthesis_symbol_expressions() {
 }
 
 /**
- * Maps token value to token type.
+ * Parenthesis symbols, computed once at compile time.
+ */
+inline constexpr auto parenthesis_symbols = parenthesis_symbol_expressions();
+
+/**
+ * Gets the parenthesis symbols used as delimiters when tokenizing expressions.
+ * The view refers to constant storage, so no string needs to be built.
+ *
+ * @return Parenthesis symbols
+ */
+constexpr std::string_view parenthesis_delimiters() noexcept {
+    return { parenthesis_symbols.data(), parenthesis_symbols.size() };
+}
+
+namespace detail {
+
+/**
+ * Converts an ASCII uppercase letter to lowercase. Other characters,
+ * including the symbol characters, are returned unchanged.
+ *
+ * @param c Character
+ *
+ * @return Lowercase character
+ */
+constexpr char to_lower(char const c) noexcept {
+    return 'A' <= c && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * Compares a lowercase token expression with a token value,
+ * ignoring the case of the value.
+ *
+ * @param expression Lowercase token expression
+ * @param value      Token value
+ *
+ * @return True if the value matches the expression, false otherwise
+ */
+constexpr bool iequals(std::string_view const expression, std::string_view const value) noexcept {
+    if (expression.size() != value.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        if (expression[i] != to_lower(value[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Number of slots in the token classifier table. Must be a power of two.
+ */
+constexpr std::size_t classifier_bits{ 6 };
+constexpr std::size_t classifier_size{ std::size_t{ 1 } << classifier_bits };
+
+/**
+ * Hashes a non-empty token value by its length and case-folded first and
+ * last characters, which is enough to tell all keywords and symbols apart.
  *
  * @param value Token value
+ * @param seed  Multiplier of the hash
  *
- * @return Token type
+ * @return Classifier table slot
  */
-constexpr token_type map_to_token_type(std::string_view const value) {
-    auto keyword_search = utils::find_if(
-        std::begin(keyword_expressions),
-        std::end(keyword_expressions),
-        [value](auto&& p) {
-            return p.first == value;
+constexpr std::size_t classifier_hash(std::string_view const value, uint32_t const seed) noexcept {
+    auto const key =
+        static_cast<uint32_t>(static_cast<unsigned char>(to_lower(value.front()))) |
+        static_cast<uint32_t>(static_cast<unsigned char>(to_lower(value.back()))) << 8 |
+        static_cast<uint32_t>(value.size()) << 16;
+    return static_cast<std::size_t>((key * seed) >> (32 - classifier_bits));
+}
+
+/**
+ * struct classifier
+ *
+ * Perfect hash table of all keyword and symbol expressions. Every
+ * expression occupies its own slot, so classifying a token takes a single
+ * hash and at most one comparison.
+ */
+struct classifier {
+    uint32_t seed{ 0 };
+    std::size_t max_length{ 0 };
+    std::array<std::string_view, classifier_size> expressions{};
+    std::array<token_type, classifier_size> types{};
+};
+
+/**
+ * Builds the perfect hash table by searching for a hash multiplier
+ * under which no two expressions collide.
+ *
+ * @return Token classifier
+ */
+constexpr classifier make_classifier() {
+    for (uint32_t seed = 0x9E3779B1u; ; seed += 2) {
+        classifier result{};
+        result.seed = seed;
+
+        bool collision{ false };
+        auto insert = [&result, &collision](auto const& p) {
+            auto const slot = classifier_hash(p.first, result.seed);
+            collision = collision || !result.expressions[slot].empty();
+            result.expressions[slot] = p.first;
+            result.types[slot] = p.second;
+            result.max_length = std::max(result.max_length, p.first.size());
+        };
+
+        for (auto const& p : keyword_expressions) {
+            insert(p);
         }
-    );
 
-    if (std::end(keyword_expressions) != keyword_search) {
-        return keyword_search->second;
-    }
+        for (auto const& p : symbol_expressions) {
+            insert(p);
+        }
 
-    auto symbol_search = utils::find_if(
-        std::begin(symbol_expressions),
-        std::end(symbol_expressions),
-        [value](auto&& p) {
-            return p.first == value;
+        if (!collision) {
+            return result;
         }
-    );
+    }
+}
+
+inline constexpr classifier token_classifier = make_classifier();
 
-    if (std::end(symbol_expressions) != symbol_search) {
-        return symbol_search->second;
+} // detail
+
+/**
+ * Maps token value to token type. Keywords are matched case-insensitively.
+ *
+ * @param value Token value
+ *
+ * @return Token type
+ */
+constexpr token_type map_to_token_type(std::string_view const value) {
+    if (value.empty() || value.size() > detail::token_classifier.max_length) {
+        return token_type::field;
     }
 
-    return token_type::field;
+    auto const slot = detail::classifier_hash(value, detail::token_classifier.seed);
+    return detail::iequals(detail::token_classifier.expressions[slot], value)
+        ? detail::token_classifier.types[slot]
+        : token_type::field;
 }
 
 /**
@@ -30,6 +30,7 @@
 #ifndef BOOLEVAL_TOKENIZER_H
 #define BOOLEVAL_TOKENIZER_H
 
+#include <string>
 #include <vector>
 #include <string_view>
 #include <booleval/token/token.hpp>
@@ -98,14 +99,38 @@ public:
 
     /**
      * Tokenizes the expression and transforms it into the collection of tokens.
+     * The collection keeps its capacity, so tokenizing expressions of similar
+     * length with the same tokenizer does not allocate memory.
      */
     void tokenize();
 
+    /**
+     * Tokenizes the expression into the caller-provided storage without allocating
+     * memory. If the storage is too small, only its capacity is filled, while the
+     * returned number of tokens tells how much storage the expression requires.
+     *
+     * @param expression Expression to be tokenized
+     * @param tokens     Pointer to the first element of the storage
+     * @param capacity   Number of tokens the storage can hold
+     *
+     * @return Number of tokens of the expression
+     */
+    [[nodiscard]] static std::size_t tokenize(std::string_view expression, token* tokens, std::size_t capacity) noexcept;
+
     /**
      * Clears the collection of tokens and sets the current index to zero.
      */
     void reset() noexcept;
 
+    /**
+     * Gets the canonical form of the tokenized expression. Expressions producing
+     * the same tokens (e.g. differing only in whitespace, spelling of operators or
+     * quoting of fields) have the same canonical form.
+     *
+     * @return Canonical form of the collection of tokens
+     */
+    [[nodiscard]] std::string canonical_form() const;
+
 private:
     std::string_view expression_;
     std::size_t current_token_index_{ 0 };
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_COLUMN_KERNELS_H
+#define BOOLEVAL_COLUMN_KERNELS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <booleval/token/token_type.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * Checks whether there is the comparison kernel for the contiguous values of the type.
+ */
+template <typename T>
+constexpr bool has_column_kernel_v =
+    std::is_same_v<T, int32_t>  ||
+    std::is_same_v<T, uint32_t> ||
+    std::is_same_v<T, int64_t>  ||
+    std::is_same_v<T, uint64_t> ||
+    std::is_same_v<T, float>    ||
+    std::is_same_v<T, double>;
+
+/**
+ * Compares the contiguous values to the literal by using the relational operator.
+ *
+ * @param values   Pointer to the first value
+ * @param count    Number of values
+ * @param literal  Literal to compare to
+ * @param relation Relational operator
+ * @param result   Words with i-th bit set if i-th value satisfies relational operation
+ */
+void compare_contiguous(int32_t const* values, std::size_t count, int32_t literal, token::token_type relation, uint64_t* result) noexcept;
+void compare_contiguous(uint32_t const* values, std::size_t count, uint32_t literal, token::token_type relation, uint64_t* result) noexcept;
+void compare_contiguous(int64_t const* values, std::size_t count, int64_t literal, token::token_type relation, uint64_t* result) noexcept;
+void compare_contiguous(uint64_t const* values, std::size_t count, uint64_t literal, token::token_type relation, uint64_t* result) noexcept;
+void compare_contiguous(float const* values, std::size_t count, float literal, token::token_type relation, uint64_t* result) noexcept;
+void compare_contiguous(double const* values, std::size_t count, double literal, token::token_type relation, uint64_t* result) noexcept;
+
+/**
+ * Combines the words by using bitwise AND.
+ *
+ * @param result Words to combine the other words into
+ * @param other  Other words
+ * @param count  Number of words
+ */
+void and_words(uint64_t* result, uint64_t const* other, std::size_t count) noexcept;
+
+/**
+ * Combines the words by using bitwise OR.
+ *
+ * @param result Words to combine the other words into
+ * @param other  Other words
+ * @param count  Number of words
+ */
+void or_words(uint64_t* result, uint64_t const* other, std::size_t count) noexcept;
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_COLUMN_KERNELS_H
\ No newline at end of file
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_COLUMN_VISITOR_H
+#define BOOLEVAL_COLUMN_VISITOR_H
+
+#include <map>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <booleval/column.hpp>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/tree/result_visitor.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * class column_visitor
+ *
+ * Represents a visitor for expression tree nodes in order to evaluate the
+ * expression for all the rows of the columns at once. Each relational
+ * operation is evaluated by a tight loop over the column of its field,
+ * while logical operations are evaluated by combining the resulting bitmaps.
+ */
+class column_visitor {
+public:
+    using column_map = std::map<std::string_view, column>;
+
+    static constexpr std::size_t rows_per_chunk{ 4096 };
+    static constexpr std::size_t words_per_chunk{ rows_per_chunk / utils::bitmap::bits_per_word };
+
+public:
+    column_visitor() = default;
+    column_visitor(column_visitor&& rhs) = default;
+    column_visitor(column_visitor const& rhs) = default;
+
+    column_visitor& operator=(column_visitor&& rhs) = default;
+    column_visitor& operator=(column_visitor const& rhs) = default;
+
+    ~column_visitor() = default;
+
+    /**
+     * Sets the evaluation mode used for logical operations. In short-circuit mode
+     * the right operand is skipped only if the left one decides the result for
+     * the whole chunk of rows.
+     *
+     * @param mode Evaluation mode
+     */
+    void mode(evaluation_mode const mode) noexcept {
+        mode_ = mode;
+    }
+
+    /**
+     * Gets the evaluation mode used for logical operations.
+     *
+     * @return Evaluation mode
+     */
+    [[nodiscard]] evaluation_mode mode() const noexcept {
+        return mode_;
+    }
+
+    /**
+     * Evaluates the expression tree for all the rows of the columns.
+     *
+     * @param tree    Expression tree to evaluate
+     * @param columns Field name - column map
+     * @param result  Bitmap with i-th bit set if i-th row satisfies the expression
+     *
+     * @throws field_not_found if the tree refers to a field without the column
+     * @throws column_size_mismatch if the columns differ in size
+     */
+    void visit(expression_tree const& tree, column_map const& columns, utils::bitmap& result) const;
+
+private:
+    /**
+     * Visits tree node for the chunk of rows.
+     *
+     * @param tree    Expression tree being visited
+     * @param node    Currently visited tree node
+     * @param columns Field name - column map
+     * @param offset  Index of the first row of the chunk
+     * @param count   Number of rows in the chunk
+     * @param result  Words with i-th bit set if i-th row of the chunk satisfies the (sub)expression
+     */
+    void visit(expression_tree const& tree,
+               tree_node const& node,
+               column_map const& columns,
+               std::size_t const offset,
+               std::size_t const count,
+               uint64_t* result) const;
+
+    /**
+     * Visits tree node representing one of relational operations for the chunk of rows.
+     *
+     * @param tree    Expression tree being visited
+     * @param node    Currently visited tree node
+     * @param columns Field name - column map
+     * @param offset  Index of the first row of the chunk
+     * @param count   Number of rows in the chunk
+     * @param result  Words with i-th bit set if i-th row of the chunk satisfies relational operation
+     */
+    void visit_relational(expression_tree const& tree,
+                          tree_node const& node,
+                          column_map const& columns,
+                          std::size_t const offset,
+                          std::size_t const count,
+                          uint64_t* result) const;
+
+private:
+    evaluation_mode mode_{ evaluation_mode::short_circuit };
+};
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_COLUMN_VISITOR_H
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef BOOLEVAL_COMPARISON_H
+#define BOOLEVAL_COMPARISON_H
+
+#include <booleval/token/token_type.hpp>
+#include <booleval/utils/any_value.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * Checks whether the result of the comparison satisfies the relational operator.
+ *
+ * @param type   Relational operator
+ * @param result Result of the comparison
+ *
+ * @return True if the result satisfies the relational operator, otherwise false
+ */
+[[nodiscard]] constexpr bool satisfies(token::token_type const type, utils::comparison_result const result) noexcept {
+    switch (type) {
+    case token::token_type::eq:
+        return utils::comparison_result::equal == result;
+
+    case token::token_type::neq:
+        return utils::comparison_result::equal != result;
+
+    case token::token_type::gt:
+        return utils::comparison_result::greater == result;
+
+    case token::token_type::lt:
+        return utils::comparison_result::less == result;
+
+    case token::token_type::geq:
+        return utils::comparison_result::greater == result ||
+               utils::comparison_result::equal   == result;
+
+    case token::token_type::leq:
+        return utils::comparison_result::less  == result ||
+               utils::comparison_result::equal == result;
+
+    default:
+        return false;
+    }
+}
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_COMPARISON_H
\ No newline at end of file
@@ -30,10 +30,11 @@
 #ifndef BOOLEVAL_EXPRESSION_TREE_H
 #define BOOLEVAL_EXPRESSION_TREE_H
 
-#include <memory>
+#include <vector>
 #include <string_view>
 #include <booleval/tree/tree_node.hpp>
 #include <booleval/token/tokenizer.hpp>
+#include <booleval/utils/any_value.hpp>
 
 namespace booleval {
 
@@ -43,7 +44,9 @@ namespace tree {
  * class expression_tree
  *
  * Represents a class for building an expression tree by using a recursive
- * descent parser method.
+ * descent parser method. Tree nodes are stored contiguously and refer to
+ * their child nodes by indices. Parsed literals are kept in a separate table,
+ * so only the leaf nodes holding a literal refer to them.
  */
 class expression_tree {
 public:
@@ -59,9 +62,91 @@ public:
     /**
      * Gets the root tree node.
      *
-     * @return Root tree node
+     * @return Root tree node or nullptr if the tree is not built
      */
-    [[nodiscard]] std::shared_ptr<tree::tree_node> root() noexcept;
+    [[nodiscard]] tree_node const* root() const noexcept;
+
+    /**
+     * Gets the root tree node.
+     *
+     * @return Root tree node or nullptr if the tree is not built
+     */
+    [[nodiscard]] tree_node* root() noexcept;
+
+    /**
+     * Sets the root tree node.
+     *
+     * @param index Index of the root tree node
+     */
+    void root(node_index const index) noexcept;
+
+    /**
+     * Gets the tree node with the specified index.
+     *
+     * @param index Index of the tree node
+     *
+     * @return Tree node
+     */
+    [[nodiscard]] tree_node const& node(node_index const index) const noexcept {
+        return nodes_[index];
+    }
+
+    /**
+     * Gets the tree node with the specified index.
+     *
+     * @param index Index of the tree node
+     *
+     * @return Tree node
+     */
+    [[nodiscard]] tree_node& node(node_index const index) noexcept {
+        return nodes_[index];
+    }
+
+    /**
+     * Gets the index of the tree node.
+     *
+     * @param node Tree node (must belong to this tree)
+     *
+     * @return Index of the tree node
+     */
+    [[nodiscard]] node_index index_of(tree_node const& node) const noexcept {
+        return static_cast<node_index>(&node - nodes_.data());
+    }
+
+    /**
+     * Gets all the tree nodes.
+     *
+     * @return Tree nodes
+     */
+    [[nodiscard]] std::vector<tree_node> const& nodes() const noexcept {
+        return nodes_;
+    }
+
+    /**
+     * Gets the parsed literal of the leaf node.
+     *
+     * @param node Leaf node on the right-hand side of a relational operation
+     *
+     * @return Parsed literal (empty if the node does not have one)
+     */
+    [[nodiscard]] utils::any_value const& literal(tree_node const& node) const noexcept {
+        static utils::any_value const unparsed;
+        return unparsed_literal == node.literal_index ? unparsed : literals_[node.literal_index];
+    }
+
+    /**
+     * Adds the new node to the tree.
+     *
+     * @param node Tree node to add
+     *
+     * @return Index of the added tree node
+     */
+    [[nodiscard]] node_index add_node(tree_node node);
+
+    /**
+     * Removes all the nodes from the tree.
+     */
+    void clear() noexcept;
 
     /**
      * Builds the expression tree.
@@ -78,39 +163,41 @@ private:
      *
      * @return Root tree node for the current part of the expression
      */
-    [[nodiscard]] std::shared_ptr<tree::tree_node> parse_expression();
+    [[nodiscard]] node_index parse_expression();
 
     /**
      * Parses logical operation AND.
      *
      * @return Root tree node for the parsed logical operation
      */
-    [[nodiscard]] std::shared_ptr<tree::tree_node> parse_and_operation();
+    [[nodiscard]] node_index parse_and_operation();
 
     /**
      * Parses new expression within parentheses.
      *
      * @return Root tree node for the parsed expression within parentheses
      */
-    [[nodiscard]] std::shared_ptr<tree::tree_node> parse_parentheses();
+    [[nodiscard]] node_index parse_parentheses();
 
     /**
      * Parses relational operation (EQ, NEQ, GT, LT, GEQ and LEQ).
      *
      * @return Root tree node for the parsed relational operation
      */
-    [[nodiscard]] std::shared_ptr<tree::tree_node> parse_relational_operation();
+    [[nodiscard]] node_index parse_relational_operation();
 
     /**
      * Parses terminal.
      *
      * @return Leaf node
      */
-    [[nodiscard]] std::shared_ptr<tree::tree_node> parse_terminal();
+    [[nodiscard]] node_index parse_terminal();
 
 private:
     token::tokenizer tokenizer_;
-    std::shared_ptr<tree::tree_node> root_;
+    std::vector<tree_node> nodes_;
+    std::vector<utils::any_value> literals_;
+    node_index root_{ null_node };
 };
 
 } // tree
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_NODE_PROFILER_H
+#define BOOLEVAL_NODE_PROFILER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/token/token_type.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * struct node_statistics
+ *
+ * Represents the statistics collected for a logical or relational operation
+ * of the expression, which is identified by its position in the expression text.
+ */
+struct node_statistics {
+    std::size_t begin{ 0 };
+    std::size_t end{ 0 };
+    std::string_view text;
+    token::token_type type{ token::token_type::unknown };
+    uint64_t evaluations{ 0 };
+    uint64_t satisfied{ 0 };
+    uint64_t timed_evaluations{ 0 };
+    uint64_t accessor_nanoseconds{ 0 };
+
+    /**
+     * Gets the fraction of evaluations which satisfied the operation.
+     *
+     * @return Selectivity of the operation (zero if it was never evaluated)
+     */
+    [[nodiscard]] double selectivity() const noexcept {
+        return 0 == evaluations ? 0.0 : static_cast<double>(satisfied) / evaluations;
+    }
+
+    /**
+     * Gets the average time spent in the field's member function, measured
+     * on a sample of the evaluations of relational operations.
+     *
+     * @return Average time in nanoseconds (zero if no evaluation was timed)
+     */
+    [[nodiscard]] double mean_accessor_nanoseconds() const noexcept {
+        return 0 == timed_evaluations ? 0.0 : static_cast<double>(accessor_nanoseconds) / timed_evaluations;
+    }
+};
+
+/**
+ * class node_profiler
+ *
+ * Counts the evaluations of each node of the expression tree and how often they
+ * were satisfied. Counters are relaxed atomics kept on separate cache lines,
+ * so the same profiler can be updated from any number of threads. Calls of
+ * field member functions are timed only once every timing_period evaluations
+ * of the node, which keeps the cost of reading the clock low.
+ */
+class node_profiler {
+public:
+    static constexpr uint64_t timing_period{ 64 };
+
+    explicit node_profiler(std::size_t const count_of_nodes)
+        : counters_(std::make_unique<counters[]>(count_of_nodes)),
+          size_(count_of_nodes)
+    {}
+
+    node_profiler(node_profiler&& rhs) = delete;
+    node_profiler(node_profiler const& rhs) = delete;
+
+    node_profiler& operator=(node_profiler&& rhs) = delete;
+    node_profiler& operator=(node_profiler const& rhs) = delete;
+
+    ~node_profiler() = default;
+
+    /**
+     * Records the evaluations of the node.
+     *
+     * @param index       Index of the node
+     * @param evaluations Number of evaluations
+     * @param satisfied   Number of evaluations which satisfied the node
+     */
+    void record(node_index const index, uint64_t const evaluations, uint64_t const satisfied) const noexcept {
+        counters_[index].evaluations.fetch_add(evaluations, std::memory_order_relaxed);
+        counters_[index].satisfied.fetch_add(satisfied, std::memory_order_relaxed);
+    }
+
+    /**
+     * Checks whether the next evaluation of the node should be timed.
+     *
+     * @param index Index of the node
+     *
+     * @return True if the evaluation should be timed, otherwise false
+     */
+    [[nodiscard]] bool timed(node_index const index) const noexcept {
+        return 0 == counters_[index].evaluations.load(std::memory_order_relaxed) % timing_period;
+    }
+
+    /**
+     * Records the time of a single call of the node's field member function.
+     *
+     * @param index       Index of the node
+     * @param nanoseconds Time spent in the member function
+     */
+    void record_time(node_index const index, uint64_t const nanoseconds) const noexcept {
+        counters_[index].timed.fetch_add(1, std::memory_order_relaxed);
+        counters_[index].nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the counters of the node. Position and text of the node are not set.
+     *
+     * @param index Index of the node
+     *
+     * @return Statistics of the node
+     */
+    [[nodiscard]] node_statistics statistics(node_index const index) const noexcept;
+
+    /**
+     * Resets all the counters.
+     */
+    void reset() const noexcept;
+
+    /**
+     * Gets the statistics of all the logical and relational operations of the
+     * tree, in the order of their positions in the expression text.
+     *
+     * @param tree Expression tree the profiler counts the evaluations of
+     * @param text Expression text the tree is built from
+     *
+     * @return Statistics of the operations
+     */
+    [[nodiscard]] std::vector<node_statistics> report(expression_tree const& tree, std::string_view text) const;
+
+private:
+    struct alignas(64) counters {
+        std::atomic<uint64_t> evaluations{ 0 };
+        std::atomic<uint64_t> satisfied{ 0 };
+        std::atomic<uint64_t> timed{ 0 };
+        std::atomic<uint64_t> nanoseconds{ 0 };
+    };
+
+    std::unique_ptr<counters[]> counters_;
+    std::size_t size_;
+};
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_NODE_PROFILER_H
\ No newline at end of file
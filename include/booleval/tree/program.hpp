@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_PROGRAM_H
+#define BOOLEVAL_PROGRAM_H
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <booleval/token/token_type.hpp>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/utils/any_value.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * enum class evaluation_strategy
+ *
+ * Represents the way the expression is evaluated. The expression tree can
+ * either be walked recursively or compiled to a linear program which is then
+ * executed by an interpreter loop.
+ */
+enum class [[nodiscard]] evaluation_strategy : uint8_t {
+    tree_walk = 0,
+    bytecode  = 1
+};
+
+/**
+ * enum class opcode
+ *
+ * Represents the operation performed by a single program instruction.
+ */
+enum class [[nodiscard]] opcode : uint8_t {
+    load_field    = 0, // Loads the value of the field with the specified index
+    compare       = 1, // Compares the loaded value to the constant with the specified index
+    jump_if_false = 2, // Skips the specified number of instructions if the result is false
+    jump_if_true  = 3, // Skips the specified number of instructions if the result is true
+    load_result   = 4, // Sets the result to the specified value (0 or 1)
+    record_result = 5  // Records the result of the node with the specified index (profiled programs only)
+};
+
+/**
+ * struct instruction
+ *
+ * Represents a single program instruction. The meaning of the operand
+ * depends on the instruction's opcode.
+ */
+struct instruction {
+    opcode code{ opcode::load_result };
+    token::token_type relation{ token::token_type::unknown };
+    uint32_t operand{ 0 };
+};
+
+/**
+ * struct constant
+ *
+ * Represents the literal the loaded field values are compared to. It contains
+ * both the literal as it is written in the expression and its parsed value.
+ */
+struct constant {
+    std::string_view text;
+    utils::any_value value;
+};
+
+/**
+ * class program
+ *
+ * Represents the expression tree flattened to a linear sequence of instructions.
+ * Logical operations are compiled to conditional forward jumps, so the operands
+ * that do not affect the result are skipped (short-circuit evaluation).
+ * The result of the program is the result of the last executed instruction.
+ *
+ * Profiled program records the result of every logical and relational
+ * operation once it is evaluated. Its jumps are not threaded, so the end of
+ * each operation is reached even if its right operand is skipped.
+ */
+class program {
+public:
+    program() = default;
+    program(program&& rhs) = default;
+    program(program const& rhs) = default;
+
+    program& operator=(program&& rhs) = default;
+    program& operator=(program const& rhs) = default;
+
+    ~program() = default;
+
+    /**
+     * Compiles the expression tree. Field leaf nodes of the tree need to be
+     * resolved beforehand, since the program refers to fields by their indices.
+     *
+     * @param tree     Expression tree to compile
+     * @param profiled Whether the results of the operations are recorded
+     */
+    void compile(expression_tree const& tree, bool const profiled = false);
+
+    /**
+     * Removes all the instructions and constants from the program.
+     */
+    void clear() noexcept;
+
+    /**
+     * Checks whether the program contains any instructions.
+     *
+     * @return True if the program is empty, otherwise false
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return instructions_.empty();
+    }
+
+    /**
+     * Checks whether the program records the results of the operations.
+     *
+     * @return True if the program is profiled, otherwise false
+     */
+    [[nodiscard]] bool profiled() const noexcept {
+        return profiled_;
+    }
+
+    /**
+     * Gets the index of the tree node the instruction is compiled from.
+     * Only profiled programs keep the indices of the nodes.
+     *
+     * @param pc Index of the instruction
+     *
+     * @return Index of the tree node
+     */
+    [[nodiscard]] node_index node(std::size_t const pc) const noexcept {
+        return nodes_[pc];
+    }
+
+    /**
+     * Gets the instructions of the program.
+     *
+     * @return Instructions
+     */
+    [[nodiscard]] std::vector<instruction> const& instructions() const noexcept {
+        return instructions_;
+    }
+
+    /**
+     * Gets the constants the instructions refer to.
+     *
+     * @return Constants
+     */
+    [[nodiscard]] std::vector<constant> const& constants() const noexcept {
+        return constants_;
+    }
+
+private:
+    /**
+     * Emits instructions for the tree node and all its child nodes.
+     *
+     * @param tree Expression tree being compiled
+     * @param node Currently compiled tree node
+     */
+    void compile(expression_tree const& tree, tree_node const& node);
+
+    /**
+     * Appends the instruction compiled from the tree node.
+     *
+     * @param instruction Instruction to append
+     * @param node        Index of the tree node
+     */
+    void emit(instruction const& instruction, node_index const node);
+
+    /**
+     * Redirects jumps landing on other jumps straight to their final targets.
+     */
+    void thread_jumps() noexcept;
+
+private:
+    std::vector<instruction> instructions_;
+    std::vector<constant> constants_;
+    std::vector<node_index> nodes_;
+    bool profiled_{ false };
+};
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_PROGRAM_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef BOOLEVAL_REORDER_H
+#define BOOLEVAL_REORDER_H
+
+#include <booleval/tree/node_profiler.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * Reorders the operands of each chain of the same logical operation (AND or OR)
+ * by the statistics the profiler collected for them, so the operands which are
+ * most likely to decide the result at the lowest cost are evaluated first.
+ * The cost of an operand is the time spent in the fields' member functions per
+ * its evaluation, and operands are ordered by their cost divided by the fraction
+ * of evaluations they decide the result of the operation in (failed ones for AND,
+ * satisfied ones for OR). Logical operations are commutative and associative, so
+ * the results of evaluations do not change, only the order in which the fields'
+ * member functions are called. Operands which were never evaluated are moved
+ * after the evaluated ones, keeping their current order, and each chain is
+ * rebuilt as a left-deep one, in the way the parser builds it.
+ *
+ * @param tree     Expression tree to reorder
+ * @param profiler Profiler which counted the evaluations of the tree (or of the
+ *                 tree built from the same expression)
+ *
+ * @return True if the order of any operands changed, otherwise false
+ */
+[[nodiscard]] bool reorder_operands(expression_tree& tree, node_profiler const& profiler);
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_REORDER_H
\ No newline at end of file
@@ -31,16 +31,37 @@
 #define BOOLEVAL_RESULT_VISITOR_H
 
 #include <map>
+#include <chrono>
+#include <vector>
+#include <cstdint>
 #include <functional>
 #include <string_view>
 #include <booleval/exceptions.hpp>
+#include <booleval/tree/program.hpp>
+#include <booleval/tree/comparison.hpp>
 #include <booleval/tree/tree_node.hpp>
+#include <booleval/tree/node_profiler.hpp>
+#include <booleval/tree/expression_tree.hpp>
 #include <booleval/utils/any_mem_fn.hpp>
+#include <booleval/utils/selection.hpp>
 
 namespace booleval {
 
 namespace tree {
 
+/**
+ * enum class evaluation_mode
+ *
+ * Represents the way logical operations are evaluated. In short-circuit mode
+ * the right operand is not evaluated if the left one already determines the
+ * result, while in eager mode both operands are always evaluated (useful when
+ * field getters have side effects).
+ */
+enum class [[nodiscard]] evaluation_mode : uint8_t {
+    short_circuit = 0,
+    eager         = 1
+};
+
 /**
  * class result_visitor
  *
@@ -66,100 +87,486 @@ public:
      *
      * @param fields Key - member function map
      */
-    void fields(field_map const& fields) noexcept {
-        fields_ = fields;
+    void fields(field_map const& fields) {
+        indices_.clear();
+        accessors_.clear();
+        for (auto const& [name, accessor] : fields) {
+            indices_.emplace(name, accessors_.size());
+            accessors_.push_back(accessor);
+        }
+    }
+
+    /**
+     * Links field leaf nodes of the tree to the fields' member functions so that
+     * fields do not need to be looked up by their names on each evaluation.
+     * Tree needs to be resolved again whenever the fields change.
+     *
+     * @param tree Expression tree to resolve
+     * @param node Currently resolved tree node
+     *
+     * @throws field_not_found if the tree refers to a field that does not exist
+     */
+    void resolve(expression_tree& tree, tree_node& node) const;
+
+    /**
+     * Sets the evaluation mode used for logical operations.
+     *
+     * @param mode Evaluation mode
+     */
+    void mode(evaluation_mode const mode) noexcept {
+        mode_ = mode;
+    }
+
+    /**
+     * Gets the evaluation mode used for logical operations.
+     *
+     * @return Evaluation mode
+     */
+    [[nodiscard]] evaluation_mode mode() const noexcept {
+        return mode_;
+    }
+
+    /**
+     * Sets the profiler counting the evaluations of the tree nodes. Profiling
+     * is disabled by default and when null pointer is passed in.
+     *
+     * @param profiler Profiler created for the visited tree (must outlive the visitor)
+     */
+    void profiler(node_profiler const* profiler) noexcept {
+        profiler_ = profiler;
     }
 
     /**
      * Visits tree node by checking token type and passing node itself
-     * to specialized visitor's function.
+     * to specialized visitor's function. Evaluations are counted
+     * by the profiler, if it is set.
      *
+     * @param tree Expression tree being visited
      * @param node Currently visited tree node
+     * @param obj  Object to be evaluated
      *
      * @return ReturnType
      */
     template <typename T>
-    [[nodiscard]] constexpr bool visit(tree_node const& node, T const& obj);
+    [[nodiscard]] constexpr bool visit(expression_tree const& tree, tree_node const& node, T const& obj) const {
+        if (nullptr == profiler_) {
+            return visit_node(tree, node, obj);
+        }
+
+        auto const result = visit_node(tree, node, obj);
+        profiler_->record(tree.index_of(node), 1, result ? 1 : 0);
+        return result;
+    }
+
+    /**
+     * Visits tree node for a batch of (up to 64) objects at once, so the
+     * dispatch on the node's type is done once per batch instead of once
+     * per object. Only the selected objects are evaluated. In short-circuit
+     * mode the right operand of AND is evaluated only for the objects which
+     * satisfy the left one, and the right operand of OR only for the objects
+     * which do not, so the cost of each operand depends on the selectivity
+     * of the operands visited before it.
+     *
+     * @param tree    Expression tree being visited
+     * @param node    Currently visited tree node
+     * @param objects Pointers to objects to be evaluated
+     * @param rows    Selection of the objects to be evaluated
+     *
+     * @return Bitmask with i-th bit set if i-th object is selected and satisfies the (sub)expression
+     */
+    template <typename T>
+    [[nodiscard]] uint64_t visit_batch(expression_tree const& tree,
+                                       tree_node const& node,
+                                       T const* const* objects,
+                                       utils::selection const rows) const {
+        if (nullptr == profiler_) {
+            return visit_node_batch(tree, node, objects, rows);
+        }
+
+        auto const result = visit_node_batch(tree, node, objects, rows);
+        profiler_->record(tree.index_of(node), rows.count(), utils::popcount(result));
+        return result;
+    }
+
+    /**
+     * Executes the program compiled from the expression tree. Program always
+     * evaluates logical operations in short-circuit mode. Profiled program
+     * counts the evaluations of the operations by the profiler, if it is set.
+     *
+     * @param program Program to be executed
+     * @param obj     Object to be evaluated
+     *
+     * @return True if the object's members satisfy the program, otherwise false
+     */
+    template <typename T>
+    [[nodiscard]] bool run(program const& program, T const& obj) const;
 
 private:
+    using clock = std::chrono::steady_clock;
 
     /**
-     * Visits tree node representing one of logical operations.
+     * Visits tree node by checking token type and passing node itself
+     * to specialized visitor's function.
      *
+     * @param tree Expression tree being visited
      * @param node Currently visited tree node
      * @param obj  Object to be evaluated
-     * @param func Logical operation function
+     *
+     * @return Result of the (sub)expression
+     */
+    template <typename T>
+    [[nodiscard]] constexpr bool visit_node(expression_tree const& tree, tree_node const& node, T const& obj) const;
+
+    /**
+     * Visits tree node for a batch of objects by checking token type and
+     * passing node itself to specialized visitor's function.
+     *
+     * @param tree    Expression tree being visited
+     * @param node    Currently visited tree node
+     * @param objects Pointers to objects to be evaluated
+     * @param rows    Selection of the objects to be evaluated
+     *
+     * @return Bitmask with i-th bit set if i-th object is selected and satisfies the (sub)expression
+     */
+    template <typename T>
+    [[nodiscard]] uint64_t visit_node_batch(expression_tree const& tree,
+                                            tree_node const& node,
+                                            T const* const* objects,
+                                            utils::selection const rows) const;
+
+    /**
+     * Gets the elapsed time in nanoseconds.
+     *
+     * @param start Point in time the measurement started at
+     *
+     * @return Nanoseconds since the start
+     */
+    [[nodiscard]] static uint64_t nanoseconds_since(clock::time_point const start) noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+    }
+
+    /**
+     * Visits tree node representing one of logical operations.
+     *
+     * @param tree     Expression tree being visited
+     * @param node     Currently visited tree node
+     * @param obj      Object to be evaluated
+     * @param func     Logical operation function
+     * @param decisive Result of the left operand which determines the result
+     *                 of the whole operation (false for AND, true for OR)
      *
      * @return Result of logical operation
      */
     template <typename T, typename F>
-    [[nodiscard]] constexpr bool visit_logical(tree_node const& node, T const& obj, F&& func) {
-        return func(visit(*node.left, obj), visit(*node.right, obj));
+    [[nodiscard]] constexpr bool visit_logical(expression_tree const& tree, tree_node const& node, T const& obj, F&& func, bool const decisive) const {
+        auto const left = visit(tree, tree.node(node.left), obj);
+        if (evaluation_mode::short_circuit == mode_ && decisive == left) {
+            return left;
+        }
+
+        return func(left, visit(tree, tree.node(node.right), obj));
     }
 
     /**
      * Visits tree node representing one of relational operations.
      *
+     * @param tree Expression tree being visited
      * @param node Currently visited tree node
      * @param obj  Object to be evaluated
-     * @param func Comparison function
      *
      * @return Result of relational operation
      */
-    template <typename T, typename F>
-    [[nodiscard]] constexpr bool visit_relational(tree_node const& node, T const& obj, F&& func) {
-        auto key = node.left->token;
+    template <typename T>
+    [[nodiscard]] constexpr bool visit_relational(expression_tree const& tree, tree_node const& node, T const& obj) const {
+        auto const& key = tree.node(node.left);
+
+        std::size_t index = key.field_index;
+        if (unresolved_field == index) {
+            index = find_field(key.token.value());
+        }
 
-        auto iter = fields_.find(key.value());
-        if (iter == fields_.end()) {
-            throw field_not_found(key.value());
+        if (nullptr != profiler_) {
+            auto const node_index = tree.index_of(node);
+            if (profiler_->timed(node_index)) {
+                auto const start = clock::now();
+                auto const value = accessors_[index].invoke(obj);
+                profiler_->record_time(node_index, nanoseconds_since(start));
+                return satisfies(node.token.type(), compare(value, tree, tree.node(node.right)));
+            }
         }
 
-        auto value = node.right->token;
-        return func(iter->second.invoke(obj), value.value());
+        return satisfies(node.token.type(), compare(accessors_[index].invoke(obj), tree, tree.node(node.right)));
+    }
+
+    /**
+     * Visits tree node representing one of relational operations for a batch of objects.
+     *
+     * @param tree    Expression tree being visited
+     * @param node    Currently visited tree node
+     * @param objects Pointers to objects to be evaluated
+     * @param rows    Selection of the objects to be evaluated
+     *
+     * @return Bitmask with i-th bit set if i-th object is selected and satisfies relational operation
+     */
+    template <typename T>
+    [[nodiscard]] uint64_t visit_relational_batch(expression_tree const& tree,
+                                                  tree_node const& node,
+                                                  T const* const* objects,
+                                                  utils::selection const rows) const {
+        auto const& key = tree.node(node.left);
+
+        std::size_t index = key.field_index;
+        if (unresolved_field == index) {
+            index = find_field(key.token.value());
+        }
+
+        auto const& accessor = accessors_[index];
+        auto const& literal  = tree.node(node.right);
+        auto const  relation = node.token.type();
+
+        uint64_t result{ 0 };
+        auto remaining = rows;
+
+        // Only the first object of each batch is timed while profiling
+        if (nullptr != profiler_ && !rows.empty()) {
+            auto const i = *rows.begin();
+            auto const start = clock::now();
+            auto const value = accessor.invoke(objects[i]);
+            profiler_->record_time(tree.index_of(node), nanoseconds_since(start));
+
+            result |= uint64_t{ satisfies(relation, compare(value, tree, literal)) } << i;
+            remaining = rows.without(utils::selection(uint64_t{ 1 } << i));
+        }
+
+        remaining.for_each([&](std::size_t const i) {
+            auto const satisfied = satisfies(relation, compare(accessor.invoke(objects[i]), tree, literal));
+            result |= uint64_t{ satisfied } << i;
+        });
+
+        return result;
+    }
+
+    /**
+     * Compares the value of the field to the literal. String fields are compared
+     * to the literal as it is written in the expression, while all the other ones
+     * are compared to the value parsed while building the tree.
+     *
+     * @param value   Value of the field
+     * @param tree    Expression tree containing the literal
+     * @param literal Leaf node containing the literal
+     *
+     * @return Result of the comparison
+     */
+    [[nodiscard]] static utils::comparison_result compare(utils::any_value const& value, expression_tree const& tree, tree_node const& literal) {
+        return compare(value, literal.token.value(), tree.literal(literal));
+    }
+
+    /**
+     * Compares the value of the field to the constant of the program.
+     *
+     * @param value   Value of the field
+     * @param literal Constant the value is compared to
+     *
+     * @return Result of the comparison
+     */
+    [[nodiscard]] static utils::comparison_result compare(utils::any_value const& value, constant const& literal) {
+        return compare(value, literal.text, literal.value);
+    }
+
+    /**
+     * Compares the value of the field to the literal, by its text if the field is
+     * a string or the literal is not parsed, otherwise by its parsed value.
+     *
+     * @param value  Value of the field
+     * @param text   Literal as it is written in the expression
+     * @param parsed Parsed literal (empty if it is not parsed)
+     *
+     * @return Result of the comparison
+     */
+    [[nodiscard]] static utils::comparison_result compare(utils::any_value const& value,
+                                                          std::string_view const text,
+                                                          utils::any_value const& parsed) {
+        if (value.is_string() || parsed.empty()) {
+            return value.compare_to(text);
+        }
+
+        return utils::compare(value, parsed);
+    }
+
+    /**
+     * Finds the index of the field's member function.
+     *
+     * @param name Name of the field
+     *
+     * @return Index of the field's member function
+     *
+     * @throws field_not_found if the field does not exist
+     */
+    [[nodiscard]] std::size_t find_field(std::string_view const name) const {
+        auto iter = indices_.find(name);
+        if (iter == indices_.end()) {
+            throw field_not_found(name);
+        }
+
+        return iter->second;
     }
 
 private:
-    field_map fields_;
+    std::map<std::string_view, std::size_t> indices_;
+    std::vector<MemFn> accessors_;
+    evaluation_mode mode_{ evaluation_mode::short_circuit };
+    node_profiler const* profiler_{ nullptr };
 };
 
-template <typename MemFn>
+template <typename MemFn>
+void result_visitor<MemFn>::resolve(expression_tree& tree, tree_node& node) const {
+    if (null_node == node.left || null_node == node.right) {
+        return;
+    }
+
+    auto const is_relational_operator = node.token.is_one_of(
+        token::token_type::eq,
+        token::token_type::neq,
+        token::token_type::gt,
+        token::token_type::lt,
+        token::token_type::geq,
+        token::token_type::leq
+    );
+
+    if (is_relational_operator) {
+        auto& key = tree.node(node.left);
+        key.field_index = static_cast<uint32_t>(find_field(key.token.value()));
+    } else {
+        resolve(tree, tree.node(node.left));
+        resolve(tree, tree.node(node.right));
+    }
+}
+
+template <typename MemFn>
 template <typename T>
-constexpr bool result_visitor<MemFn>::visit(tree_node const& node, T const& obj) {
-    if (nullptr == node.left || nullptr == node.right) {
+constexpr bool result_visitor<MemFn>::visit_node(expression_tree const& tree, tree_node const& node, T const& obj) const {
+    if (null_node == node.left || null_node == node.right) {
         return false;
     }
 
     switch (node.token.type()) {
     case token::token_type::logical_and:
-        return visit_logical(node, obj, std::logical_and<>());
+        return visit_logical(tree, node, obj, std::logical_and<>(), false);
 
     case token::token_type::logical_or:
-        return visit_logical(node, obj, std::logical_or<>());
+        return visit_logical(tree, node, obj, std::logical_or<>(), true);
 
     case token::token_type::eq:
-        return visit_relational(node, obj, std::equal_to<>());
-
     case token::token_type::neq:
-        return visit_relational(node, obj, std::not_equal_to<>());
-
     case token::token_type::gt:
-        return visit_relational(node, obj, std::greater<>());
-
     case token::token_type::lt:
-        return visit_relational(node, obj, std::less<>());
-
     case token::token_type::geq:
-        return visit_relational(node, obj, std::greater_equal<>());
-
     case token::token_type::leq:
-        return visit_relational(node, obj, std::less_equal<>());
+        return visit_relational(tree, node, obj);
 
     default:
         return false;
     }
 }
-
+
+template <typename MemFn>
+template <typename T>
+uint64_t result_visitor<MemFn>::visit_node_batch(expression_tree const& tree,
+                                                 tree_node const& node,
+                                                 T const* const* objects,
+                                                 utils::selection const rows) const {
+    if (null_node == node.left || null_node == node.right) {
+        return 0;
+    }
+
+    switch (node.token.type()) {
+    case token::token_type::logical_and: {
+        auto const left = visit_batch(tree, tree.node(node.left), objects, rows);
+        if (evaluation_mode::short_circuit == mode_) {
+            auto const selected = utils::selection(left);
+            return selected.empty() ? 0 : visit_batch(tree, tree.node(node.right), objects, selected);
+        }
+        return left & visit_batch(tree, tree.node(node.right), objects, rows);
+    }
+
+    case token::token_type::logical_or: {
+        auto const left = visit_batch(tree, tree.node(node.left), objects, rows);
+        if (evaluation_mode::short_circuit == mode_) {
+            auto const remaining = rows.without(utils::selection(left));
+            return remaining.empty() ? left : left | visit_batch(tree, tree.node(node.right), objects, remaining);
+        }
+        return left | visit_batch(tree, tree.node(node.right), objects, rows);
+    }
+
+    case token::token_type::eq:
+    case token::token_type::neq:
+    case token::token_type::gt:
+    case token::token_type::lt:
+    case token::token_type::geq:
+    case token::token_type::leq:
+        return visit_relational_batch(tree, node, objects, rows);
+
+    default:
+        return 0;
+    }
+}
+
+template <typename MemFn>
+template <typename T>
+bool result_visitor<MemFn>::run(program const& program, T const& obj) const {
+    auto const& instructions = program.instructions();
+    auto const& constants    = program.constants();
+
+    utils::any_value value;
+    bool result{ false };
+
+    for (std::size_t pc = 0; pc < instructions.size(); ++pc) {
+        auto const& instruction = instructions[pc];
+        switch (instruction.code) {
+        case opcode::load_field:
+            if (nullptr != profiler_ && program.profiled()) {
+                auto const node = program.node(pc);
+                if (profiler_->timed(node)) {
+                    auto const start = clock::now();
+                    value = accessors_[instruction.operand].invoke(obj);
+                    profiler_->record_time(node, nanoseconds_since(start));
+                    break;
+                }
+            }
+            value = accessors_[instruction.operand].invoke(obj);
+            break;
+
+        case opcode::compare:
+            result = satisfies(instruction.relation, compare(value, constants[instruction.operand]));
+            break;
+
+        case opcode::jump_if_false:
+            if (!result) {
+                pc += instruction.operand;
+            }
+            break;
+
+        case opcode::jump_if_true:
+            if (result) {
+                pc += instruction.operand;
+            }
+            break;
+
+        case opcode::load_result:
+            result = 0 != instruction.operand;
+            break;
+
+        case opcode::record_result:
+            if (nullptr != profiler_) {
+                profiler_->record(instruction.operand, 1, result ? 1 : 0);
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
 } // tree
 
 } // booleval
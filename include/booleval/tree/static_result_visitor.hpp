@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_STATIC_RESULT_VISITOR_H
+#define BOOLEVAL_STATIC_RESULT_VISITOR_H
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <string_view>
+#include <type_traits>
+#include <booleval/field.hpp>
+#include <booleval/exceptions.hpp>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/tree/comparison.hpp>
+#include <booleval/tree/expression_tree.hpp>
+#include <booleval/utils/any_value.hpp>
+#include <booleval/tree/result_visitor.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * class static_result_visitor
+ *
+ * Represents a visitor for expression tree nodes in order to get the final
+ * result of the expression based on the fields of an object being passed.
+ * Unlike result_visitor, fields are known at compile time, so their values
+ * are obtained by calling getters directly, without any type erasure.
+ */
+template <typename T, auto const& Fields>
+class static_result_visitor {
+    using fields_type = std::remove_cv_t<std::remove_reference_t<decltype(Fields)>>;
+    static constexpr std::size_t count_of_fields{ std::tuple_size_v<fields_type> };
+
+public:
+    static_result_visitor() = default;
+    static_result_visitor(static_result_visitor&& rhs) = default;
+    static_result_visitor(static_result_visitor const& rhs) = default;
+
+    static_result_visitor& operator=(static_result_visitor&& rhs) = default;
+    static_result_visitor& operator=(static_result_visitor const& rhs) = default;
+
+    ~static_result_visitor() = default;
+
+    /**
+     * Sets the evaluation mode used for logical operations.
+     *
+     * @param mode Evaluation mode
+     */
+    void mode(evaluation_mode const mode) noexcept {
+        mode_ = mode;
+    }
+
+    /**
+     * Gets the evaluation mode used for logical operations.
+     *
+     * @return Evaluation mode
+     */
+    [[nodiscard]] evaluation_mode mode() const noexcept {
+        return mode_;
+    }
+
+    /**
+     * Links field leaf nodes of the tree to the fields' indices in the table of fields.
+     *
+     * @param tree Expression tree to resolve
+     * @param node Currently resolved tree node
+     *
+     * @throws field_not_found if the tree refers to a field that does not exist
+     */
+    void resolve(expression_tree& tree, tree_node& node) const;
+
+    /**
+     * Visits tree node by checking token type and passing node itself
+     * to specialized visitor's function.
+     *
+     * @param tree Expression tree being visited
+     * @param node Currently visited tree node
+     * @param obj  Object to be evaluated
+     *
+     * @return True if the object satisfies the (sub)expression, otherwise false
+     */
+    [[nodiscard]] bool visit(expression_tree const& tree, tree_node const& node, T const& obj) const;
+
+private:
+    /**
+     * Visits tree node representing one of logical operations.
+     *
+     * @param tree     Expression tree being visited
+     * @param node     Currently visited tree node
+     * @param obj      Object to be evaluated
+     * @param decisive Result of the left operand which determines the result
+     *                 of the whole operation (false for AND, true for OR)
+     *
+     * @return Result of logical operation
+     */
+    [[nodiscard]] bool visit_logical(expression_tree const& tree, tree_node const& node, T const& obj, bool const decisive) const {
+        auto const left = visit(tree, tree.node(node.left), obj);
+        if (evaluation_mode::short_circuit == mode_ && decisive == left) {
+            return left;
+        }
+
+        auto const right = visit(tree, tree.node(node.right), obj);
+        return decisive ? left || right : left && right;
+    }
+
+    /**
+     * Compares the value of the field with the specified index to the literal.
+     *
+     * @param index   Index of the field in the table of fields
+     * @param obj     Object to be evaluated
+     * @param literal Leaf node containing the literal
+     * @param parsed  Parsed literal (empty if it is not parsed)
+     *
+     * @return Result of the comparison
+     */
+    template <std::size_t... I>
+    [[nodiscard]] static utils::comparison_result compare_field(std::size_t const index,
+                                                                T const& obj,
+                                                                tree_node const& literal,
+                                                                utils::any_value const& parsed,
+                                                                std::index_sequence<I...>) {
+        auto result = utils::comparison_result::unordered;
+        static_cast<void>((
+            (I == index && (result = compare_value(invoke_field(std::get<I>(Fields).member, obj), literal, parsed), true)) || ...
+        ));
+        return result;
+    }
+
+    /**
+     * Compares the value of the field to the literal. String fields are compared to
+     * the literal as it is written in the expression and all the other ones to its
+     * parsed value.
+     *
+     * @param value   Value of the field
+     * @param literal Leaf node containing the literal
+     * @param parsed  Parsed literal (empty if it is not parsed)
+     *
+     * @return Result of the comparison
+     */
+    template <typename V>
+    [[nodiscard]] static utils::comparison_result compare_value(V const& value, tree_node const& literal, utils::any_value const& parsed) {
+        if constexpr (std::is_convertible_v<V const&, std::string_view>) {
+            return utils::compare_strings(value, literal.token.value());
+        } else {
+            static_assert(std::is_arithmetic_v<V>, "Field has to be of arithmetic or string type");
+            if (parsed.empty()) {
+                return utils::compare(value, utils::parse_value(literal.token.value()));
+            }
+            return utils::compare(value, parsed);
+        }
+    }
+
+    /**
+     * Finds the index of the field in the table of fields.
+     *
+     * @param name Name of the field
+     *
+     * @return Index of the field
+     *
+     * @throws field_not_found if the field does not exist
+     */
+    [[nodiscard]] static std::size_t find_field(std::string_view const name) {
+        auto const names = std::apply(
+            [](auto const&... fields) {
+                return std::array<std::string_view, count_of_fields>{ fields.name... };
+            },
+            Fields
+        );
+
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) {
+                return i;
+            }
+        }
+
+        throw field_not_found(name);
+    }
+
+private:
+    evaluation_mode mode_{ evaluation_mode::short_circuit };
+};
+
+template <typename T, auto const& Fields>
+void static_result_visitor<T, Fields>::resolve(expression_tree& tree, tree_node& node) const {
+    if (null_node == node.left || null_node == node.right) {
+        return;
+    }
+
+    auto const is_relational_operator = node.token.is_one_of(
+        token::token_type::eq,
+        token::token_type::neq,
+        token::token_type::gt,
+        token::token_type::lt,
+        token::token_type::geq,
+        token::token_type::leq
+    );
+
+    if (is_relational_operator) {
+        auto& key = tree.node(node.left);
+        key.field_index = static_cast<uint32_t>(find_field(key.token.value()));
+    } else {
+        resolve(tree, tree.node(node.left));
+        resolve(tree, tree.node(node.right));
+    }
+}
+
+template <typename T, auto const& Fields>
+bool static_result_visitor<T, Fields>::visit(expression_tree const& tree, tree_node const& node, T const& obj) const {
+    if (null_node == node.left || null_node == node.right) {
+        return false;
+    }
+
+    switch (node.token.type()) {
+    case token::token_type::logical_and:
+        return visit_logical(tree, node, obj, false);
+
+    case token::token_type::logical_or:
+        return visit_logical(tree, node, obj, true);
+
+    case token::token_type::eq:
+    case token::token_type::neq:
+    case token::token_type::gt:
+    case token::token_type::lt:
+    case token::token_type::geq:
+    case token::token_type::leq: {
+        auto const& key = tree.node(node.left);
+
+        std::size_t index = key.field_index;
+        if (unresolved_field == index) {
+            index = find_field(key.token.value());
+        }
+
+        auto const& literal = tree.node(node.right);
+        auto const  result  = compare_field(index, obj, literal, tree.literal(literal), std::make_index_sequence<count_of_fields>{});
+        return satisfies(node.token.type(), result);
+    }
+
+    default:
+        return false;
+    }
+}
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_STATIC_RESULT_VISITOR_H
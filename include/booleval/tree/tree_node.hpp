@@ -30,7 +30,8 @@
 #ifndef BOOLEVAL_TREE_NODE_H
 #define BOOLEVAL_TREE_NODE_H
 
-#include <memory>
+#include <limits>
+#include <cstdint>
 #include <booleval/token/token.hpp>
 #include <booleval/token/token_type.hpp>
 
@@ -38,27 +39,55 @@ namespace booleval {
 
 namespace tree {
 
+/**
+ * Represents the index of a tree node within the expression tree.
+ */
+using node_index = uint32_t;
+
+/**
+ * Index referring to no tree node, i.e. the missing child node.
+ */
+constexpr node_index null_node{ std::numeric_limits<node_index>::max() };
+
+/**
+ * Field index of the leaf nodes not linked to any field.
+ */
+constexpr uint32_t unresolved_field{ std::numeric_limits<uint32_t>::max() };
+
+/**
+ * Literal index of the leaf nodes without the parsed literal.
+ */
+constexpr uint32_t unparsed_literal{ std::numeric_limits<uint32_t>::max() };
+
 /**
  * struct tree_node
  *
- * Represents the tree node containing references to left and right child nodes
+ * Represents the tree node containing indices of left and right child nodes
  * as well as the token that the node represents in the actual expression tree.
+ * All the nodes of the expression tree are stored contiguously, so child nodes
+ * are referred to by their indices instead of pointers.
+ * Leaf nodes on the left-hand side of relational operations contain the index
+ * of the field they refer to, while the ones on the right-hand side contain the
+ * index of the literal, parsed once while building the expression tree and kept
+ * in the tree's table of literals.
  */
 struct tree_node {
     token::token token{ token::token_type::unknown };
-    std::shared_ptr<tree_node> left;
-    std::shared_ptr<tree_node> right;
+    node_index left{ null_node };
+    node_index right{ null_node };
+    uint32_t field_index{ unresolved_field };
+    uint32_t literal_index{ unparsed_literal };
 
-    constexpr tree_node() = default;
+    tree_node() = default;
 
     tree_node(tree_node&& rhs) = default;
     tree_node(tree_node const& rhs) = default;
 
-    constexpr tree_node(token::token_type const type)
+    tree_node(token::token_type const type)
         : token(type)
     {}
 
-    constexpr tree_node(token::token const& token)
+    tree_node(token::token const& token)
         : token(token)
     {}
 
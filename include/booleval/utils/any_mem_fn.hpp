@@ -30,55 +30,170 @@
 #ifndef BOOLEVAL_ANY_MEM_FN_H
 #define BOOLEVAL_ANY_MEM_FN_H
 
-#include <any>
-#include <functional>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <booleval/utils/type_id.hpp>
 #include <booleval/utils/any_value.hpp>
 
 namespace booleval {
 
 namespace utils {
 
+/**
+ * class mem_fn_storage
+ *
+ * Represents the storage for a pointer to member function of any class and
+ * signature, used for type erasure of member functions without any allocation.
+ * The pointer is trivially copyable, so its bytes are copied in and out of the storage.
+ */
+class mem_fn_storage {
+    // Pointer to member function of an incomplete class has the most general representation
+    class any_class;
+    using any_mem_fn_ptr = void (any_class::*)() const;
+
+public:
+    mem_fn_storage() = default;
+
+    template <typename M>
+    mem_fn_storage(M const m) noexcept {
+        static_assert(std::is_member_function_pointer_v<M>, "Member function pointer expected");
+        static_assert(std::is_trivially_copyable_v<M>, "Member function pointer must be trivially copyable");
+        static_assert(sizeof(M) <= sizeof(storage_), "Member function pointer too large");
+        std::memcpy(storage_, &m, sizeof(M));
+    }
+
+    /**
+     * Gets the stored pointer to member function.
+     *
+     * @return Pointer to member function
+     */
+    template <typename M>
+    [[nodiscard]] M get() const noexcept {
+        M m;
+        std::memcpy(&m, storage_, sizeof(M));
+        return m;
+    }
+
+private:
+    unsigned char storage_[sizeof(any_mem_fn_ptr)]{};
+};
+
+/**
+ * Converts the value returned by a member function to any_value. Strings returned
+ * by reference are referred to instead of being copied.
+ *
+ * @param value Value returned by a member function
+ *
+ * @return Value as any_value
+ */
+template <typename Ret>
+[[nodiscard]] any_value make_any_value(Ret&& value) {
+    if constexpr (std::is_lvalue_reference_v<Ret> &&
+                  std::is_convertible_v<Ret, std::string_view>) {
+        return std::string_view(value);
+    } else {
+        return std::forward<Ret>(value);
+    }
+}
+
+/**
+ * Gets the object referred to by the argument, dereferencing it if it is a pointer.
+ *
+ * @param obj Object or pointer to the object
+ *
+ * @return Pointer to the object (nullptr for null pointers)
+ */
+template <typename T>
+[[nodiscard]] constexpr auto object_address(T const& obj) noexcept {
+    if constexpr (std::is_pointer_v<T>) {
+        return static_cast<std::remove_pointer_t<T> const*>(obj);
+    } else {
+        return &obj;
+    }
+}
+
 /**
  * class any_mem_fn
  *
- * Represents class member function of any signature.
+ * Represents class member function of any signature. Object is passed to the
+ * member function by reference (or pointer), so it is never copied. Class of
+ * the member function is identified on construction, so invoking it on the
+ * object of some other class is detected by comparing type identifiers.
  */
 class any_mem_fn {
+    using invoke_fn = any_value (*)(mem_fn_storage const&, void const*);
+
 public:
     any_mem_fn() = default;
     any_mem_fn(any_mem_fn&& rhs) = default;
     any_mem_fn(any_mem_fn const& rhs) = default;
 
     template <typename Ret, typename C>
-    any_mem_fn(Ret (C::*m)()) {
-        fn_ = [m](std::any a) {
-            return (std::any_cast<C>(a).*m)();
-        };
-    }
+    any_mem_fn(Ret (C::*m)())
+        : storage_(m),
+          invoke_(&invoke_member<Ret (C::*)(), C>),
+          class_(type_id_of<C>())
+    {}
 
     template <typename Ret, typename C>
-    any_mem_fn(Ret (C::*m)() const) {
-        fn_ = [m](std::any a) {
-            return (std::any_cast<C>(a).*m)();
-        };
-    }
+    any_mem_fn(Ret (C::*m)() const)
+        : storage_(m),
+          invoke_(&invoke_member<Ret (C::*)() const, C>),
+          class_(type_id_of<C>())
+    {}
 
     any_mem_fn& operator=(any_mem_fn&& rhs) = default;
     any_mem_fn& operator=(any_mem_fn const& rhs) = default;
 
     ~any_mem_fn() = default;
 
+    /**
+     * Gets the identifier of the class the member function belongs to.
+     *
+     * @return Class identifier
+     */
+    [[nodiscard]] type_id class_id() const noexcept {
+        return class_;
+    }
+
+    /**
+     * Invokes the member function on the object passed in. If the object
+     * (or the object pointed to) is not of the member function's class,
+     * empty value is returned.
+     *
+     * @param obj Object or pointer to the object
+     *
+     * @return Value returned by the member function
+     */
     template <typename T>
-    any_value invoke(T obj) {
-        try {
-            return fn_(obj);
-        } catch (std::bad_any_cast const&) {
+    [[nodiscard]] any_value invoke(T const& obj) const {
+        using C = std::remove_cv_t<std::remove_pointer_t<T>>;
+
+        auto const address = object_address(obj);
+        if (nullptr == invoke_ || nullptr == address || type_id_of<C>() != class_) {
             return {};
         }
+
+        return invoke_(storage_, address);
+    }
+
+private:
+    // Thunk is only ever called through the function pointer, and keeping it out of line
+    // stops GCC from checking the virtual-call path of the opaque member pointer against
+    // objects smaller than a vtable pointer
+    template <typename M, typename C>
+    [[gnu::noinline]] static any_value invoke_member(mem_fn_storage const& storage, void const* obj) {
+        // Non-const member functions are supported for convenience and are
+        // expected not to modify the object
+        auto& c = const_cast<C&>(*static_cast<C const*>(obj));
+        return make_any_value((c.*storage.get<M>())());
     }
 
 private:
-    std::function<any_value(std::any)> fn_;
+    mem_fn_storage storage_;
+    invoke_fn invoke_{ nullptr };
+    type_id class_{ nullptr };
 };
 
 /**
@@ -89,46 +204,80 @@ private:
  */
 class any_mem_fn_bool
 {
+    using invoke_fn = any_value (*)(mem_fn_storage const&, void const*, bool&);
+
 public:
     any_mem_fn_bool() = default;
     any_mem_fn_bool(any_mem_fn_bool&& rhs) = default;
     any_mem_fn_bool(any_mem_fn_bool const& rhs) = default;
 
     template <typename Ret, typename C>
-    any_mem_fn_bool(Ret(C::* m)(bool&)) {
-        fn_ = [m](std::any a, bool& is_valid) {
-            return (std::any_cast<C>(a).*m)(is_valid);
-        };
-    }
+    any_mem_fn_bool(Ret(C::* m)(bool&))
+        : storage_(m),
+          invoke_(&invoke_member<Ret(C::*)(bool&), C>),
+          class_(type_id_of<C>())
+    {}
 
     template <typename Ret, typename C>
-    any_mem_fn_bool(Ret(C::* m)(bool&) const) {
-        fn_ = [m](std::any a, bool& is_valid) {
-            return (std::any_cast<C>(a).*m)(is_valid);
-        };
-    }
+    any_mem_fn_bool(Ret(C::* m)(bool&) const)
+        : storage_(m),
+          invoke_(&invoke_member<Ret(C::*)(bool&) const, C>),
+          class_(type_id_of<C>())
+    {}
 
     any_mem_fn_bool& operator=(any_mem_fn_bool&& rhs) = default;
     any_mem_fn_bool& operator=(any_mem_fn_bool const& rhs) = default;
 
     ~any_mem_fn_bool() = default;
 
+    /**
+     * Gets the identifier of the class the member function belongs to.
+     *
+     * @return Class identifier
+     */
+    [[nodiscard]] type_id class_id() const noexcept {
+        return class_;
+    }
+
+    /**
+     * Invokes the member function on the object passed in. If the object
+     * (or the object pointed to) is not of the member function's class or
+     * the member function reports invalid value, empty value is returned.
+     *
+     * @param obj Object or pointer to the object
+     *
+     * @return Value returned by the member function
+     */
     template <typename T>
-    any_value invoke(T obj) {
-        try {
-            bool is_valid = false;
-            auto ret = fn_(obj, is_valid);
-            if (is_valid) {
-                return ret;
-            }
-            return {};
-        } catch (std::bad_any_cast const&) {
+    [[nodiscard]] any_value invoke(T const& obj) const {
+        using C = std::remove_cv_t<std::remove_pointer_t<T>>;
+
+        auto const address = object_address(obj);
+        if (nullptr == invoke_ || nullptr == address || type_id_of<C>() != class_) {
             return {};
         }
+
+        bool is_valid = false;
+        auto ret = invoke_(storage_, address, is_valid);
+        if (is_valid) {
+            return ret;
+        }
+        return {};
+    }
+
+private:
+    template <typename M, typename C>
+    [[gnu::noinline]] static any_value invoke_member(mem_fn_storage const& storage, void const* obj, bool& is_valid) {
+        // Non-const member functions are supported for convenience and are
+        // expected not to modify the object
+        auto& c = const_cast<C&>(*static_cast<C const*>(obj));
+        return make_any_value((c.*storage.get<M>())(is_valid));
     }
 
 private:
-    std::function<any_value(std::any, bool&)> fn_;
+    mem_fn_storage storage_;
+    invoke_fn invoke_{ nullptr };
+    type_id class_{ nullptr };
 };
 
 } // utils
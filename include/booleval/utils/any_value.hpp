@@ -31,20 +31,53 @@
 #define BOOLEVAL_ANY_VALUE_H
 
 #include <string>
+#include <cstdint>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <variant>
+#include <charconv>
+#include <string_view>
 #include <type_traits>
-#include <booleval/utils/string_utils.hpp>
 
 namespace booleval {
 
 namespace utils {
 
+/**
+ * enum class comparison_result
+ *
+ * Represents the result of comparing two values. Values of incompatible
+ * types (e.g. number and text) as well as NaNs are unordered.
+ */
+enum class [[nodiscard]] comparison_result : uint8_t {
+    less      = 0,
+    equal     = 1,
+    greater   = 2,
+    unordered = 3
+};
+
 /**
  * class any_value
  *
  * Represents the class that accepts any type of value through its constructor
- * or assignment operator and internally stores its string version.
+ * or assignment operator and internally stores it as a tagged union of
+ * boolean, signed integer, unsigned integer, floating point or string value.
+ * Values are compared natively, i.e. without any conversion to text.
  */
 class any_value {
+    using value_type = std::variant<
+        std::monostate,
+        bool,
+        int64_t,
+        uint64_t,
+        float,
+        double,
+        std::string_view,
+        std::string
+    >;
+
 public:
     any_value() = default;
     any_value(any_value&& rhs) = default;
@@ -52,253 +85,593 @@ public:
 
     template <typename T,
               typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-    any_value(T const rhs);
+    any_value(T const rhs) noexcept;
 
-    template <typename T,
-              typename std::enable_if_t<std::is_constructible_v<std::string, T>>* = nullptr>
-    any_value(T const rhs);
+    /**
+     * Constructs the value referring to the string view passed in.
+     * Referred characters need to outlive the value.
+     */
+    any_value(std::string_view const rhs) noexcept
+        : value_(rhs)
+    {}
+
+    any_value(char const* rhs) noexcept
+        : value_(std::string_view(rhs))
+    {}
+
+    any_value(std::string rhs)
+        : value_(std::move(rhs))
+    {}
 
     any_value& operator=(any_value&& rhs) = default;
     any_value& operator=(any_value const& rhs) = default;
 
     template <typename T,
               typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-    any_value& operator=(T const rhs);
+    any_value& operator=(T const rhs) noexcept;
 
     template <typename T,
-              typename std::enable_if_t<std::is_constructible_v<std::string, T>>* = nullptr>
-    any_value& operator=(T const rhs);
+              typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>* = nullptr>
+    any_value& operator=(T const& rhs);
 
     template <typename T,
               typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-    [[nodiscard]] bool operator==(T const rhs);
+    [[nodiscard]] bool operator==(T const rhs) const noexcept;
 
     template <typename T,
-              typename std::enable_if_t<std::is_constructible_v<std::string, T>>* = nullptr>
-    [[nodiscard]] bool operator==(T const rhs);
+              typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>* = nullptr>
+    [[nodiscard]] bool operator==(T const& rhs) const;
 
     template <typename T,
               typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-    [[nodiscard]] bool operator!=(T const rhs);
+    [[nodiscard]] bool operator!=(T const rhs) const noexcept;
 
     template <typename T,
-              typename std::enable_if_t<std::is_constructible_v<std::string, T>>* = nullptr>
-    [[nodiscard]] bool operator!=(T const rhs);
+              typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>* = nullptr>
+    [[nodiscard]] bool operator!=(T const& rhs) const;
 
     template <typename T,
               typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-    [[nodiscard]] bool operator>(T const rhs);
+    [[nodiscard]] bool operator>(T const rhs) const noexcept;
 
     template <typename T,
-              typename std::enable_if_t<std::is_constructible_v<std::string, T>>* = nullptr>
-    [[nodiscard]] bool operator>(T const rhs);
+              typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>* = nullptr>
+    [[nodiscard]] bool operator>(T const& rhs) const;
 
     template <typename T,
               typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-    [[nodiscard]] bool operator<(T const rhs);
+    [[nodiscard]] bool operator<(T const rhs) const noexcept;
 
     template <typename T,
-              typename std::enable_if_t<std::is_constructible_v<std::string, T>>* = nullptr>
-    [[nodiscard]] bool operator<(T const rhs);
+              typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>* = nullptr>
+    [[nodiscard]] bool operator<(T const& rhs) const;
 
     template <typename T,
               typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-    [[nodiscard]] bool operator>=(T const rhs);
+    [[nodiscard]] bool operator>=(T const rhs) const noexcept;
 
     template <typename T,
-              typename std::enable_if_t<std::is_constructible_v<std::string, T>>* = nullptr>
-    [[nodiscard]] bool operator>=(T const rhs);
+              typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>* = nullptr>
+    [[nodiscard]] bool operator>=(T const& rhs) const;
 
     template <typename T,
               typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-    [[nodiscard]] bool operator<=(T const rhs);
+    [[nodiscard]] bool operator<=(T const rhs) const noexcept;
 
     template <typename T,
-              typename std::enable_if_t<std::is_constructible_v<std::string, T>>* = nullptr>
-    [[nodiscard]] bool operator<=(T const rhs);
+              typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>* = nullptr>
+    [[nodiscard]] bool operator<=(T const& rhs) const;
 
     ~any_value() = default;
 
-    [[nodiscard]] std::string const& str() const noexcept {
-        return value_;
+    /**
+     * Checks whether the value is empty, i.e. nothing has been assigned to it.
+     *
+     * @return True if the value is empty, otherwise false
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return std::holds_alternative<std::monostate>(value_);
+    }
+
+    /**
+     * Checks whether the value holds a string.
+     *
+     * @return True if the value holds a string, otherwise false
+     */
+    [[nodiscard]] bool is_string() const noexcept {
+        return std::holds_alternative<std::string_view>(value_) ||
+               std::holds_alternative<std::string>(value_);
+    }
+
+    /**
+     * Invokes the visitor with the value of its actual type
+     * (std::monostate if the value is empty).
+     *
+     * @param visitor Callable accepting the value of any of the supported types
+     *
+     * @return Result of the visitor
+     */
+    template <typename Visitor>
+    decltype(auto) visit(Visitor&& visitor) const {
+        return std::visit(std::forward<Visitor>(visitor), value_);
     }
 
-    friend bool operator==(any_value const& lhs, any_value const& rhs);
-    friend bool operator!=(any_value const& lhs, any_value const& rhs);
+    /**
+     * Compares the value to the text passed in. If the value is not a string,
+     * text is converted to an arithmetic value first.
+     *
+     * @param rhs Text to compare the value to
+     *
+     * @return Result of the comparison
+     */
+    [[nodiscard]] comparison_result compare_to(std::string_view rhs) const;
+
+    friend comparison_result compare(any_value const& lhs, any_value const& rhs) noexcept;
 
 private:
-    std::string value_;
-    bool use_string_comparison_{ false };
+    value_type value_;
 };
 
+/**
+ * Compares the integer to the floating point value exactly. The integer is never
+ * converted to the floating point type, which could round it, but the integral
+ * part of the floating point value is compared to the integer instead.
+ *
+ * @param lhs Integer
+ * @param rhs Floating point value
+ *
+ * @return Result of the comparison
+ */
+template <typename I, typename F>
+[[nodiscard]] constexpr comparison_result compare_integer_to_floating(I const lhs, F const rhs) noexcept {
+    if constexpr (std::is_same_v<I, bool>) {
+        return compare_integer_to_floating(static_cast<uint64_t>(lhs), rhs);
+    } else {
+        // Both bounds of the integral type's range are zero or powers of two,
+        // so they are represented exactly
+        constexpr auto lower = static_cast<F>(std::numeric_limits<I>::min());
+        constexpr auto upper = static_cast<F>(std::numeric_limits<I>::max() / 2 + 1) * F{ 2 };
+
+        if (rhs != rhs) {
+            return comparison_result::unordered;
+        } else if (rhs < lower) {
+            return comparison_result::greater;
+        } else if (rhs >= upper) {
+            return comparison_result::less;
+        }
+
+        auto const integral = static_cast<I>(rhs);
+        if (lhs < integral) {
+            return comparison_result::less;
+        } else if (lhs > integral) {
+            return comparison_result::greater;
+        }
+
+        // Fraction of the floating point value decides between equal integral parts
+        auto const fraction = rhs - static_cast<F>(integral);
+        if (fraction > 0) {
+            return comparison_result::less;
+        } else if (fraction < 0) {
+            return comparison_result::greater;
+        }
+        return comparison_result::equal;
+    }
+}
+
+/**
+ * Compares two arithmetic values without converting them to text. Integers
+ * of different signedness, as well as integers and floating point values,
+ * are compared exactly, while two floating point values are compared in
+ * the precision of the narrower floating point operand.
+ *
+ * @param lhs Left-hand side value
+ * @param rhs Right-hand side value
+ *
+ * @return Result of the comparison
+ */
+template <typename L, typename R>
+[[nodiscard]] constexpr comparison_result compare_arithmetic(L const lhs, R const rhs) noexcept {
+    if constexpr (std::is_integral_v<L> && std::is_floating_point_v<R>) {
+        return compare_integer_to_floating(lhs, rhs);
+    } else if constexpr (std::is_floating_point_v<L> && std::is_integral_v<R>) {
+        auto const result = compare_integer_to_floating(rhs, lhs);
+        if (comparison_result::less == result) {
+            return comparison_result::greater;
+        } else if (comparison_result::greater == result) {
+            return comparison_result::less;
+        }
+        return result;
+    } else if constexpr (std::is_floating_point_v<L> || std::is_floating_point_v<R>) {
+        using F = std::conditional_t<
+            std::is_same_v<L, float> || std::is_same_v<R, float>,
+            float,
+            double
+        >;
+
+        auto const l = static_cast<F>(lhs);
+        auto const r = static_cast<F>(rhs);
+        if (l < r) {
+            return comparison_result::less;
+        } else if (l > r) {
+            return comparison_result::greater;
+        } else if (l == r) {
+            return comparison_result::equal;
+        }
+
+        return comparison_result::unordered;
+    } else if constexpr (std::is_signed_v<L> && !std::is_signed_v<R>) {
+        if (lhs < 0) {
+            return comparison_result::less;
+        }
+        return compare_arithmetic(static_cast<uint64_t>(lhs), static_cast<uint64_t>(rhs));
+    } else if constexpr (!std::is_signed_v<L> && std::is_signed_v<R>) {
+        if (rhs < 0) {
+            return comparison_result::greater;
+        }
+        return compare_arithmetic(static_cast<uint64_t>(lhs), static_cast<uint64_t>(rhs));
+    } else {
+        if (lhs < rhs) {
+            return comparison_result::less;
+        } else if (lhs > rhs) {
+            return comparison_result::greater;
+        }
+        return comparison_result::equal;
+    }
+}
+
+/**
+ * Compares two strings lexicographically.
+ *
+ * @param lhs Left-hand side string
+ * @param rhs Right-hand side string
+ *
+ * @return Result of the comparison
+ */
+[[nodiscard]] constexpr comparison_result compare_strings(std::string_view const lhs,
+                                                          std::string_view const rhs) noexcept {
+    auto const result = lhs.compare(rhs);
+    if (result < 0) {
+        return comparison_result::less;
+    } else if (result > 0) {
+        return comparison_result::greater;
+    }
+    return comparison_result::equal;
+}
+
+/**
+ * Compares two values. Strings are compared lexicographically, arithmetic
+ * values natively, while any other combination is unordered.
+ *
+ * @param lhs Left-hand side value
+ * @param rhs Right-hand side value
+ *
+ * @return Result of the comparison
+ */
+[[nodiscard]] inline comparison_result compare(any_value const& lhs, any_value const& rhs) noexcept {
+    return std::visit(
+        [](auto const& l, auto const& r) {
+            using L = std::decay_t<decltype(l)>;
+            using R = std::decay_t<decltype(r)>;
+
+            if constexpr (std::is_arithmetic_v<L> && std::is_arithmetic_v<R>) {
+                return compare_arithmetic(l, r);
+            } else if constexpr (std::is_convertible_v<L const&, std::string_view> &&
+                                 std::is_convertible_v<R const&, std::string_view>) {
+                return compare_strings(l, r);
+            } else {
+                return comparison_result::unordered;
+            }
+        },
+        lhs.value_,
+        rhs.value_
+    );
+}
+
+/**
+ * Compares an arithmetic value to the value of any type without
+ * constructing any_value out of it first.
+ *
+ * @param lhs Left-hand side arithmetic value
+ * @param rhs Right-hand side value
+ *
+ * @return Result of the comparison
+ */
 template <typename T,
-          typename std::enable_if_t<std::is_arithmetic_v<T>>*>
-any_value::any_value(T const rhs)
-    : value_(utils::to_chars<T>(rhs)),
-      use_string_comparison_(false)
-{}
+          typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
+[[nodiscard]] comparison_result compare(T const lhs, any_value const& rhs) noexcept {
+    return rhs.visit(
+        [lhs](auto const& r) {
+            using R = std::decay_t<decltype(r)>;
+
+            if constexpr (std::is_arithmetic_v<R>) {
+                return compare_arithmetic(lhs, r);
+            } else {
+                return comparison_result::unordered;
+            }
+        }
+    );
+}
+
+/**
+ * Checks whether the string view is a number written in decimal notation, i.e.
+ * an optional minus sign, digits with an optional decimal point and an optional
+ * exponent. Infinities, NaNs and hexadecimal numbers are not accepted.
+ *
+ * @param strv String view to check
+ *
+ * @return True if the string view is a decimal number, otherwise false
+ */
+[[nodiscard]] constexpr bool is_decimal_number(std::string_view const strv) noexcept {
+    auto const is_digit = [](char const c) { return '0' <= c && c <= '9'; };
+
+    std::size_t i{ 0 };
+    if (i < strv.size() && '-' == strv[i]) {
+        ++i;
+    }
+
+    std::size_t digits{ 0 };
+    for (; i < strv.size() && is_digit(strv[i]); ++i) {
+        ++digits;
+    }
+    if (i < strv.size() && '.' == strv[i]) {
+        for (++i; i < strv.size() && is_digit(strv[i]); ++i) {
+            ++digits;
+        }
+    }
+    if (0 == digits) {
+        return false;
+    }
+
+    if (i < strv.size() && ('e' == strv[i] || 'E' == strv[i])) {
+        ++i;
+        if (i < strv.size() && ('+' == strv[i] || '-' == strv[i])) {
+            ++i;
+        }
+
+        std::size_t exponent_digits{ 0 };
+        for (; i < strv.size() && is_digit(strv[i]); ++i) {
+            ++exponent_digits;
+        }
+        if (0 == exponent_digits) {
+            return false;
+        }
+    }
+
+    return strv.size() == i;
+}
+
+/**
+ * Converts from string view to the arithmetic value. Integers are stored as
+ * signed values if they fit, otherwise as unsigned ones, and all the other
+ * numbers as double precision floating point values.
+ * If string view is not a decimal number, empty value is returned, so the
+ * same text is converted in the same way with any standard library.
+ *
+ * @param strv String view to convert to arithmetic value
+ *
+ * @return Arithmetic value
+ */
+[[nodiscard]] inline any_value parse_arithmetic(std::string_view const strv) {
+    if (!is_decimal_number(strv)) {
+        return {};
+    }
+
+    auto const first = strv.data();
+    auto const last  = strv.data() + strv.size();
+
+    int64_t signed_value{};
+    auto const signed_result = std::from_chars(first, last, signed_value);
+    if (std::errc() == signed_result.ec && last == signed_result.ptr) {
+        return signed_value;
+    }
+
+    uint64_t unsigned_value{};
+    auto const unsigned_result = std::from_chars(first, last, unsigned_value);
+    if (std::errc() == unsigned_result.ec && last == unsigned_result.ptr) {
+        return unsigned_value;
+    }
+
+    double floating_value{};
+#if defined(__cpp_lib_to_chars) || defined(_MSC_VER)
+    auto const floating_result = std::from_chars(first, last, floating_value);
+    if (std::errc() == floating_result.ec && last == floating_result.ptr) {
+        return floating_value;
+    }
+#else
+    // Parsed from a copy on the stack, so that no stream needs to be allocated,
+    // with the decimal point replaced by the one of the current locale
+    char buffer[64];
+    if (strv.size() < sizeof(buffer)) {
+        std::memcpy(buffer, strv.data(), strv.size());
+        buffer[strv.size()] = '\0';
+
+        auto const point = std::memchr(buffer, '.', strv.size());
+        if (nullptr != point) {
+            *static_cast<char*>(point) = *std::localeconv()->decimal_point;
+        }
+
+        char* end{ nullptr };
+        floating_value = std::strtod(buffer, &end);
+        if (buffer + strv.size() == end) {
+            return floating_value;
+        }
+    }
+#endif
+
+    return {};
+}
+
+/**
+ * Converts from string view to the value of the matching type. Boolean
+ * keywords (true / false) are converted to boolean values, numbers to
+ * arithmetic values and everything else is referred to as a string.
+ *
+ * @param strv String view to convert
+ *
+ * @return Converted value
+ */
+[[nodiscard]] inline any_value parse_value(std::string_view const strv) {
+    if ("true" == strv || "TRUE" == strv) {
+        return true;
+    } else if ("false" == strv || "FALSE" == strv) {
+        return false;
+    }
+
+    auto arithmetic = parse_arithmetic(strv);
+    if (!arithmetic.empty()) {
+        return arithmetic;
+    }
+
+    return strv;
+}
 
 template <typename T,
-          typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
-any_value::any_value(T const rhs)
-    : value_(rhs),
-      use_string_comparison_(true)
-{}
+          typename std::enable_if_t<std::is_arithmetic_v<T>>*>
+any_value::any_value(T const rhs) noexcept {
+    *this = rhs;
+}
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
-any_value& any_value::operator=(T const rhs) {
-    value_ = utils::to_chars<T>(rhs);
-    use_string_comparison_ = false;
+any_value& any_value::operator=(T const rhs) noexcept {
+    if constexpr (std::is_same_v<T, bool>) {
+        value_ = rhs;
+    } else if constexpr (std::is_same_v<T, float>) {
+        value_ = rhs;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        value_ = static_cast<double>(rhs);
+    } else if constexpr (std::is_signed_v<T>) {
+        value_ = static_cast<int64_t>(rhs);
+    } else {
+        value_ = static_cast<uint64_t>(rhs);
+    }
     return *this;
 }
 
 template <typename T,
-          typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
-any_value& any_value::operator=(T const rhs) {
-    value_ = rhs;
-    use_string_comparison_ = true;
+          typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>*>
+any_value& any_value::operator=(T const& rhs) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        value_ = rhs;
+    } else {
+        value_ = std::string_view(rhs);
+    }
     return *this;
 }
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
-bool any_value::operator==(T const rhs) {
-    return value_ == utils::to_chars<T>(rhs);
+bool any_value::operator==(T const rhs) const noexcept {
+    return comparison_result::equal == compare(*this, rhs);
 }
 
 template <typename T,
-          typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
-bool any_value::operator==(T const rhs) {
-    return value_ == rhs;
+          typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>*>
+bool any_value::operator==(T const& rhs) const {
+    return comparison_result::equal == compare_to(rhs);
 }
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
-bool any_value::operator!=(T const rhs) {
-    return value_ != utils::to_chars<T>(rhs);
+bool any_value::operator!=(T const rhs) const noexcept {
+    return comparison_result::equal != compare(*this, rhs);
 }
 
 template <typename T,
-          typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
-bool any_value::operator!=(T const rhs) {
-    return value_ != rhs;
+          typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>*>
+bool any_value::operator!=(T const& rhs) const {
+    return comparison_result::equal != compare_to(rhs);
 }
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
-bool any_value::operator>(T const rhs) {
-    auto arithmetic_lhs = utils::from_chars<T>(value_);
-    if (arithmetic_lhs) {
-        return arithmetic_lhs.value() > rhs;
-    }
-
-    return false;
+bool any_value::operator>(T const rhs) const noexcept {
+    return comparison_result::greater == compare(*this, rhs);
 }
 
 template <typename T,
-          typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
-bool any_value::operator>(T const rhs) {
-    if (use_string_comparison_) {
-        return value_ > rhs;
-    }
-
-    auto arithmetic_lhs = utils::from_chars<double>(value_);
-    auto arithmetic_rhs = utils::from_chars<double>(rhs);
-    if (arithmetic_lhs && arithmetic_rhs) {
-        return arithmetic_lhs.value() > arithmetic_rhs.value();
-    }
-
-    return false;
+          typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>*>
+bool any_value::operator>(T const& rhs) const {
+    return comparison_result::greater == compare_to(rhs);
 }
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
-bool any_value::operator<(T const rhs) {
-    auto arithmetic_lhs = utils::from_chars<T>(value_);
-    if (arithmetic_lhs) {
-        return arithmetic_lhs.value() < rhs;
-    }
-
-    return false;
+bool any_value::operator<(T const rhs) const noexcept {
+    return comparison_result::less == compare(*this, rhs);
 }
 
 template <typename T,
-          typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
-bool any_value::operator<(T const rhs) {
-    if (use_string_comparison_) {
-        return value_ < rhs;
-    }
-
-    auto arithmetic_lhs = utils::from_chars<double>(value_);
-    auto arithmetic_rhs = utils::from_chars<double>(rhs);
-    if (arithmetic_lhs && arithmetic_rhs) {
-        return arithmetic_lhs.value() < arithmetic_rhs.value();
-    }
-
-    return false;
+          typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>*>
+bool any_value::operator<(T const& rhs) const {
+    return comparison_result::less == compare_to(rhs);
 }
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
-bool any_value::operator>=(T const rhs) {
-    auto arithmetic_lhs = utils::from_chars<T>(value_);
-    if (arithmetic_lhs) {
-        return arithmetic_lhs.value() >= rhs;
-    }
-
-    return false;
+bool any_value::operator>=(T const rhs) const noexcept {
+    auto const result = compare(*this, rhs);
+    return comparison_result::greater == result ||
+           comparison_result::equal   == result;
 }
 
 template <typename T,
-          typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
-bool any_value::operator>=(T const rhs) {
-    if (use_string_comparison_) {
-        return value_ >= rhs;
-    }
-
-    auto arithmetic_lhs = utils::from_chars<double>(value_);
-    auto arithmetic_rhs = utils::from_chars<double>(rhs);
-    if (arithmetic_lhs && arithmetic_rhs) {
-        return arithmetic_lhs.value() >= arithmetic_rhs.value();
-    }
-
-    return false;
+          typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>*>
+bool any_value::operator>=(T const& rhs) const {
+    auto const result = compare_to(rhs);
+    return comparison_result::greater == result ||
+           comparison_result::equal   == result;
 }
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
-bool any_value::operator<=(T const rhs) {
-    auto arithmetic_lhs = utils::from_chars<T>(value_);
-    if (arithmetic_lhs) {
-        return arithmetic_lhs.value() <= rhs;
-    }
-
-    return false;
+bool any_value::operator<=(T const rhs) const noexcept {
+    auto const result = compare(*this, rhs);
+    return comparison_result::less  == result ||
+           comparison_result::equal == result;
 }
 
 template <typename T,
-          typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
-bool any_value::operator<=(T const rhs) {
-    if (use_string_comparison_) {
-        return value_ <= rhs;
-    }
+          typename std::enable_if_t<std::is_convertible_v<T const&, std::string_view>>*>
+bool any_value::operator<=(T const& rhs) const {
+    auto const result = compare_to(rhs);
+    return comparison_result::less  == result ||
+           comparison_result::equal == result;
+}
 
-    auto arithmetic_lhs = utils::from_chars<double>(value_);
-    auto arithmetic_rhs = utils::from_chars<double>(rhs);
-    if (arithmetic_lhs && arithmetic_rhs) {
-        return arithmetic_lhs.value() <= arithmetic_rhs.value();
+inline comparison_result any_value::compare_to(std::string_view const rhs) const {
+    if (is_string()) {
+        return compare(*this, rhs);
     }
+    return compare(*this, parse_arithmetic(rhs));
+}
+
+[[nodiscard]] inline bool operator==(any_value const& lhs, any_value const& rhs) noexcept {
+    return comparison_result::equal == compare(lhs, rhs);
+}
+
+[[nodiscard]] inline bool operator!=(any_value const& lhs, any_value const& rhs) noexcept {
+    return comparison_result::equal != compare(lhs, rhs);
+}
+
+[[nodiscard]] inline bool operator>(any_value const& lhs, any_value const& rhs) noexcept {
+    return comparison_result::greater == compare(lhs, rhs);
+}
 
-    return false;
+[[nodiscard]] inline bool operator<(any_value const& lhs, any_value const& rhs) noexcept {
+    return comparison_result::less == compare(lhs, rhs);
 }
 
-[[nodiscard]] inline bool operator==(any_value const& lhs, any_value const& rhs) {
-    return lhs.value_ == rhs.value_;
+[[nodiscard]] inline bool operator>=(any_value const& lhs, any_value const& rhs) noexcept {
+    auto const result = compare(lhs, rhs);
+    return comparison_result::greater == result ||
+           comparison_result::equal   == result;
 }
 
-[[nodiscard]] inline bool operator!=(any_value const& lhs, any_value const& rhs) {
-    return lhs.value_ != rhs.value_;
+[[nodiscard]] inline bool operator<=(any_value const& lhs, any_value const& rhs) noexcept {
+    auto const result = compare(lhs, rhs);
+    return comparison_result::less  == result ||
+           comparison_result::equal == result;
 }
 
 } // utils
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BITMAP_H
+#define BOOLEVAL_BITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <booleval/utils/selection.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class bitmap
+ *
+ * Represents a fixed-size sequence of bits packed into 64-bit words.
+ * Bits beyond the size of the bitmap in its last word are always zero.
+ */
+class bitmap {
+public:
+    static constexpr std::size_t bits_per_word{ 64 };
+
+    bitmap() = default;
+    bitmap(bitmap&& rhs) = default;
+    bitmap(bitmap const& rhs) = default;
+
+    explicit bitmap(std::size_t const size)
+        : size_(size),
+          words_(count_of_words(size), 0)
+    {}
+
+    bitmap& operator=(bitmap&& rhs) = default;
+    bitmap& operator=(bitmap const& rhs) = default;
+
+    ~bitmap() = default;
+
+    /**
+     * Gets the number of bits in the bitmap.
+     *
+     * @return Number of bits
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /**
+     * Changes the number of bits in the bitmap and clears all the bits.
+     *
+     * @param size New number of bits
+     */
+    void resize(std::size_t const size) {
+        size_ = size;
+        words_.assign(count_of_words(size), 0);
+    }
+
+    /**
+     * Clears all the bits.
+     */
+    void reset() noexcept {
+        std::fill(std::begin(words_), std::end(words_), 0);
+    }
+
+    /**
+     * Gets the value of the bit at the specified position.
+     *
+     * @param index Position of the bit
+     *
+     * @return True if the bit is set, otherwise false
+     */
+    [[nodiscard]] bool test(std::size_t const index) const noexcept {
+        return 0 != (words_[index / bits_per_word] & mask(index));
+    }
+
+    /**
+     * Sets the value of the bit at the specified position.
+     *
+     * @param index Position of the bit
+     * @param value Value of the bit
+     */
+    void set(std::size_t const index, bool const value = true) noexcept {
+        if (value) {
+            words_[index / bits_per_word] |= mask(index);
+        } else {
+            words_[index / bits_per_word] &= ~mask(index);
+        }
+    }
+
+    /**
+     * Gets the number of bits set.
+     *
+     * @return Number of bits set
+     */
+    [[nodiscard]] std::size_t count() const noexcept {
+        std::size_t count{ 0 };
+        for (auto const word : words_) {
+            count += popcount(word);
+        }
+        return count;
+    }
+
+    /**
+     * Gets the number of words the bits are packed into.
+     *
+     * @return Number of words
+     */
+    [[nodiscard]] std::size_t words() const noexcept {
+        return words_.size();
+    }
+
+    /**
+     * Gets the word with the specified index.
+     *
+     * @param index Index of the word
+     *
+     * @return Word containing bits [64 * index, 64 * index + 63]
+     */
+    [[nodiscard]] uint64_t word(std::size_t const index) const noexcept {
+        return words_[index];
+    }
+
+    /**
+     * Sets the word with the specified index.
+     *
+     * @param index Index of the word
+     * @param value Word containing bits [64 * index, 64 * index + 63]
+     */
+    void word(std::size_t const index, uint64_t const value) noexcept {
+        words_[index] = value;
+    }
+
+private:
+    [[nodiscard]] static constexpr std::size_t count_of_words(std::size_t const size) noexcept {
+        return (size + bits_per_word - 1) / bits_per_word;
+    }
+
+    [[nodiscard]] static constexpr uint64_t mask(std::size_t const index) noexcept {
+        return uint64_t{ 1 } << (index % bits_per_word);
+    }
+
+private:
+    std::size_t size_{ 0 };
+    std::vector<uint64_t> words_;
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_BITMAP_H
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_CHAR_SET_H
+#define BOOLEVAL_CHAR_SET_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class char_set
+ *
+ * Represents a set of characters that can be searched for in a string.
+ * Small sets are searched for 16 or 32 characters at a time by using
+ * the instruction set selected for the column kernels, while larger
+ * sets fall back to a table lookup per character.
+ */
+class char_set {
+public:
+    /**
+     * Maximum number of distinct characters searched for with SIMD instructions.
+     */
+    static constexpr std::size_t max_vector_size{ 8 };
+
+    constexpr char_set() = default;
+
+    constexpr explicit char_set(std::string_view const chars) noexcept {
+        insert(chars);
+    }
+
+    /**
+     * Adds the character to the set.
+     *
+     * @param c Character to add
+     */
+    constexpr void insert(char const c) noexcept {
+        if (contains(c)) {
+            return;
+        }
+
+        auto const byte = static_cast<unsigned char>(c);
+        table_[byte / 64] |= uint64_t{ 1 } << (byte % 64);
+
+        if (size_ < max_vector_size) {
+            chars_[size_] = c;
+        }
+        ++size_;
+    }
+
+    /**
+     * Adds all the characters to the set.
+     *
+     * @param chars Characters to add
+     */
+    constexpr void insert(std::string_view const chars) noexcept {
+        for (auto const c : chars) {
+            insert(c);
+        }
+    }
+
+    /**
+     * Checks whether the character belongs to the set.
+     *
+     * @param c Character to check
+     *
+     * @return True if the character belongs to the set, false otherwise
+     */
+    [[nodiscard]] constexpr bool contains(char const c) const noexcept {
+        auto const byte = static_cast<unsigned char>(c);
+        return 0 != (table_[byte / 64] & (uint64_t{ 1 } << (byte % 64)));
+    }
+
+    /**
+     * Gets the number of distinct characters in the set.
+     *
+     * @return Number of characters
+     */
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /**
+     * Checks whether the set is empty.
+     *
+     * @return True if the set is empty, false otherwise
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return 0 == size_;
+    }
+
+    /**
+     * Finds the first character in the range [first, last) that belongs to the set.
+     *
+     * @param first Pointer to the first character of the range to examine
+     * @param last  Pointer past the last character of the range to examine
+     *
+     * @return Pointer to the first matching character or last if there is none
+     */
+    [[nodiscard]] char const* find_first(char const* first, char const* last) const noexcept;
+
+private:
+    [[nodiscard]] char const* find_first_scalar(char const* first, char const* last) const noexcept;
+
+private:
+    std::array<uint64_t, 4> table_{};
+    std::array<char, max_vector_size> chars_{};
+    std::size_t size_{ 0 };
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_CHAR_SET_H
\ No newline at end of file
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_EPOCH_H
+#define BOOLEVAL_EPOCH_H
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class epoch_domain
+ *
+ * Represents an epoch-based reclamation domain. Readers register a slot once
+ * and then, around each access to a shared object, announce the global epoch
+ * they observed (enter) and clear it again (leave), which costs two atomic
+ * stores and never blocks. Writers unlink an object from the shared location
+ * first and then retire it: retiring advances the global epoch and the object
+ * is destroyed once every reader inside a critical section has announced an
+ * epoch not older than the one the object was retired in, i.e. once no reader
+ * can still hold a pointer to it.
+ */
+class epoch_domain {
+public:
+    static constexpr std::size_t default_readers{ 64 };
+
+    /**
+     * Creates the domain with the fixed number of reader slots.
+     *
+     * @param max_readers Maximum number of readers registered at the same time
+     */
+    explicit epoch_domain(std::size_t const max_readers = default_readers);
+
+    epoch_domain(epoch_domain&& rhs) = delete;
+    epoch_domain(epoch_domain const& rhs) = delete;
+
+    epoch_domain& operator=(epoch_domain&& rhs) = delete;
+    epoch_domain& operator=(epoch_domain const& rhs) = delete;
+
+    /**
+     * Destroys all the retired objects. No reader may be inside a critical section.
+     */
+    ~epoch_domain();
+
+    /**
+     * Registers the reader.
+     *
+     * @return Index of the reader's slot
+     *
+     * @throws too_many_readers if all the slots are taken
+     */
+    [[nodiscard]] std::size_t acquire_slot();
+
+    /**
+     * Unregisters the reader.
+     *
+     * @param slot Index of the reader's slot
+     */
+    void release_slot(std::size_t const slot) noexcept;
+
+    /**
+     * Starts the reader's critical section, after which the shared
+     * object loaded by the reader is not destroyed until it leaves.
+     *
+     * @param slot Index of the reader's slot
+     */
+    void enter(std::size_t const slot) noexcept {
+        slots_[slot].epoch.store(epoch_.load());
+    }
+
+    /**
+     * Ends the reader's critical section.
+     *
+     * @param slot Index of the reader's slot
+     */
+    void leave(std::size_t const slot) noexcept {
+        slots_[slot].epoch.store(quiescent);
+    }
+
+    /**
+     * Retires the object which is no longer reachable from the shared location
+     * and destroys all the retired objects no reader can hold anymore.
+     *
+     * @param object Pointer to the object to retire
+     */
+    template <typename T>
+    void retire(T const* object) {
+        if (nullptr != object) {
+            retire(const_cast<T*>(object), [](void* pointer) { delete static_cast<T*>(pointer); });
+        }
+    }
+
+    /**
+     * Destroys all the retired objects no reader can hold anymore.
+     *
+     * @return Number of retired objects still waiting to be destroyed
+     */
+    std::size_t reclaim();
+
+    /**
+     * Gets the number of retired objects waiting to be destroyed.
+     *
+     * @return Number of retired objects
+     */
+    [[nodiscard]] std::size_t retired() const;
+
+private:
+    static constexpr uint64_t quiescent{ 0 };
+
+    /**
+     * struct reader_slot
+     *
+     * Represents the epoch announced by a reader, padded to its own cache line
+     * so readers on different cores do not invalidate each other's slots.
+     */
+    struct alignas(64) reader_slot {
+        std::atomic<uint64_t> epoch{ quiescent };
+        std::atomic<bool> used{ false };
+    };
+
+    /**
+     * struct retired_object
+     *
+     * Represents an object waiting to be destroyed.
+     */
+    struct retired_object {
+        void* object;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    void retire(void* object, void (*deleter)(void*));
+    std::size_t reclaim_locked();
+
+private:
+    std::unique_ptr<reader_slot[]> slots_;
+    std::size_t count_of_slots_;
+    std::atomic<uint64_t> epoch_{ 1 };
+
+    mutable std::mutex mutex_;
+    std::vector<retired_object> retired_;
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_EPOCH_H
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_INSTRUCTION_SET_H
+#define BOOLEVAL_INSTRUCTION_SET_H
+
+#include <cstdint>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * enum class instruction_set
+ *
+ * Represents the instruction set used by the vectorized kernels.
+ */
+enum class [[nodiscard]] instruction_set : uint8_t {
+    scalar = 0,
+    sse42  = 1,
+    avx2   = 2
+};
+
+/**
+ * Gets the most capable instruction set supported by the CPU, as reported by cpuid.
+ *
+ * @return Supported instruction set
+ */
+[[nodiscard]] instruction_set supported_instruction_set() noexcept;
+
+/**
+ * Gets the instruction set used by the kernels. It is selected on first use
+ * as the most capable instruction set supported by the CPU.
+ *
+ * @return Active instruction set
+ */
+[[nodiscard]] instruction_set active_instruction_set() noexcept;
+
+/**
+ * Sets the instruction set used by the kernels. Instruction sets not supported
+ * by the CPU are replaced by the most capable supported one.
+ *
+ * @param set Instruction set to use
+ */
+void active_instruction_set(instruction_set const set) noexcept;
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_INSTRUCTION_SET_H
\ No newline at end of file
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_SELECTION_H
+#define BOOLEVAL_SELECTION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * Counts the bits set in the word.
+ *
+ * @param word Word to count the bits of
+ *
+ * @return Number of bits set
+ */
+[[nodiscard]] constexpr std::size_t popcount(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+    std::size_t count{ 0 };
+    for (; 0 != word; word &= word - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * Counts the consecutive zero bits, starting from the least significant one.
+ *
+ * @param word Word to count the bits of (must not be zero)
+ *
+ * @return Position of the lowest bit set
+ */
+[[nodiscard]] constexpr std::size_t countr_zero(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+    std::size_t count{ 0 };
+    for (; 0 == (word & 1); word >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * class selection
+ *
+ * Represents a selection vector of (up to 64) rows packed into a single word,
+ * with i-th bit set if i-th row is selected. Selected rows are iterated over
+ * in ascending order by repeatedly clearing the lowest bit set, so the cost
+ * of the iteration depends on the number of selected rows only.
+ */
+class selection {
+public:
+    static constexpr std::size_t capacity{ 64 };
+
+    /**
+     * class iterator
+     *
+     * Represents a forward iterator over the indices of the selected rows.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::size_t const*;
+        using reference         = std::size_t;
+
+        constexpr iterator() noexcept = default;
+
+        constexpr explicit iterator(uint64_t const mask) noexcept
+            : mask_(mask)
+        {}
+
+        [[nodiscard]] constexpr std::size_t operator*() const noexcept {
+            return countr_zero(mask_);
+        }
+
+        constexpr iterator& operator++() noexcept {
+            mask_ &= mask_ - 1;
+            return *this;
+        }
+
+        constexpr iterator operator++(int) noexcept {
+            auto const copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] constexpr bool operator==(iterator const& rhs) const noexcept {
+            return mask_ == rhs.mask_;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(iterator const& rhs) const noexcept {
+            return mask_ != rhs.mask_;
+        }
+
+    private:
+        uint64_t mask_{ 0 };
+    };
+
+    constexpr selection() noexcept = default;
+
+    constexpr explicit selection(uint64_t const mask) noexcept
+        : mask_(mask)
+    {}
+
+    /**
+     * Creates the selection of the first rows.
+     *
+     * @param count Number of rows to select (up to 64)
+     *
+     * @return Selection of rows [0, count)
+     */
+    [[nodiscard]] static constexpr selection first(std::size_t const count) noexcept {
+        return selection(count < capacity ? (uint64_t{ 1 } << count) - 1 : ~uint64_t{ 0 });
+    }
+
+    /**
+     * Gets the word with i-th bit set if i-th row is selected.
+     *
+     * @return Mask of the selected rows
+     */
+    [[nodiscard]] constexpr uint64_t mask() const noexcept {
+        return mask_;
+    }
+
+    /**
+     * Checks whether no row is selected.
+     *
+     * @return True if no row is selected, otherwise false
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return 0 == mask_;
+    }
+
+    /**
+     * Gets the number of selected rows.
+     *
+     * @return Number of selected rows
+     */
+    [[nodiscard]] constexpr std::size_t count() const noexcept {
+        return popcount(mask_);
+    }
+
+    /**
+     * Checks whether the row is selected.
+     *
+     * @param index Index of the row
+     *
+     * @return True if the row is selected, otherwise false
+     */
+    [[nodiscard]] constexpr bool test(std::size_t const index) const noexcept {
+        return 0 != (mask_ & (uint64_t{ 1 } << index));
+    }
+
+    /**
+     * Checks whether all the rows of the other selection are selected.
+     *
+     * @param other Other selection
+     *
+     * @return True if the other selection is a subset of this one, otherwise false
+     */
+    [[nodiscard]] constexpr bool contains(selection const other) const noexcept {
+        return other.mask_ == (mask_ & other.mask_);
+    }
+
+    /**
+     * Calls the function with the index of each selected row, in ascending order.
+     *
+     * @param func Function accepting the index of the row
+     */
+    template <typename F>
+    constexpr void for_each(F&& func) const {
+        for (auto mask = mask_; 0 != mask; mask &= mask - 1) {
+            func(countr_zero(mask));
+        }
+    }
+
+    [[nodiscard]] constexpr iterator begin() const noexcept {
+        return iterator(mask_);
+    }
+
+    [[nodiscard]] constexpr iterator end() const noexcept {
+        return iterator();
+    }
+
+    [[nodiscard]] constexpr selection operator&(selection const rhs) const noexcept {
+        return selection(mask_ & rhs.mask_);
+    }
+
+    [[nodiscard]] constexpr selection operator|(selection const rhs) const noexcept {
+        return selection(mask_ | rhs.mask_);
+    }
+
+    /**
+     * Removes the rows of the other selection from this one.
+     *
+     * @param other Rows to remove
+     *
+     * @return Selection of the rows not selected by the other selection
+     */
+    [[nodiscard]] constexpr selection without(selection const other) const noexcept {
+        return selection(mask_ & ~other.mask_);
+    }
+
+    [[nodiscard]] constexpr bool operator==(selection const rhs) const noexcept {
+        return mask_ == rhs.mask_;
+    }
+
+    [[nodiscard]] constexpr bool operator!=(selection const rhs) const noexcept {
+        return mask_ != rhs.mask_;
+    }
+
+private:
+    uint64_t mask_{ 0 };
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_SELECTION_H
\ No newline at end of file
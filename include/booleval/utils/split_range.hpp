@@ -33,6 +33,7 @@
 #include <iterator>
 #include <algorithm>
 #include <string_view>
+#include <booleval/utils/char_set.hpp>
 #include <booleval/utils/string_utils.hpp>
 
 namespace booleval {
@@ -74,8 +75,14 @@ public:
     public:
         explicit constexpr iterator(std::string_view strv, std::string_view delims) noexcept
             : strv_(strv),
-              delims_(delims),
-              prev_(std::begin(strv_)) {
+              prev_(std::begin(strv_)),
+              boundaries_(delims) {
+            if constexpr (is_set(iter_options, split_options::split_by_whitespace)) {
+                boundaries_.insert(whitespace_char);
+            }
+            if constexpr (is_set(iter_options, split_options::allow_quoted_strings)) {
+                boundaries_.insert(iter_quote_char);
+            }
             next();
         }
 
@@ -149,6 +156,8 @@ public:
 
         /**
          * Finds the iterator pointing to the beginning of the next token in the specified range.
+         * Outside of quoted strings, delimiters, whitespaces and quotes are all found in a single
+         * pass over the range.
          *
          * @param first Iterator to the first element of the range to examine
          * @param last  Iterator to the last element of the range to examine
@@ -160,34 +169,14 @@ public:
             if constexpr (is_set(iter_options, split_options::allow_quoted_strings)) {
                 if (curr_value_.quoted) {
                     return find_next_quote(first, last);
-                } else {
-                    return std::min(
-                        find_next_quote(first, last),
-                        find_next_delim(first, last)
-                    );
                 }
-            } else {
-                return find_next_delim(first, last);
             }
-        }
 
-        /**
-         * Finds the iterator pointing to the first delimiter in the specified range.
-         *
-         * @param first Iterator to the first element of the range to examine
-         * @param last  Iterator to the last element of the range to examine
-         *
-         * @return Iterator to the first delimiter
-         */
-        [[nodiscard]] constexpr std::string_view::iterator find_next_delim(std::string_view::iterator first,
-                                                                           std::string_view::iterator last) const noexcept {
-            if constexpr (is_set(iter_options, split_options::split_by_whitespace)) {
-                auto whitespace = std::find(first, last, whitespace_char);
-                auto other_delim = std::find_first_of(first, last, std::begin(delims_), std::end(delims_));
-                return std::min(whitespace, other_delim);
-            } else {
-                return std::find_first_of(first, last, std::begin(delims_), std::end(delims_));
-            }
+            auto const offset = std::distance(std::begin(strv_), first);
+            auto const length = std::distance(first, last);
+            auto const data = strv_.data() + offset;
+
+            return std::next(first, boundaries_.find_first(data, data + length) - data);
         }
 
         /**
@@ -254,11 +243,11 @@ public:
 
     private:
         std::string_view strv_;
-        std::string_view delims_;
 
         std::string_view::iterator prev_;
         std::string_view::iterator curr_;
 
+        char_set boundaries_;
         value_type curr_value_;
     };
 
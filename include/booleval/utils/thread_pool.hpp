@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_THREAD_POOL_H
+#define BOOLEVAL_THREAD_POOL_H
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class thread_pool
+ *
+ * Represents a pool of worker threads executing indexed tasks. Each worker, as
+ * well as the thread waiting for the tasks to complete, owns a queue of tasks.
+ * Tasks are distributed into the queues in contiguous blocks, every thread
+ * executes the tasks from the back of its own queue and, once it runs out of
+ * them, steals the tasks from the front of the other queues, so threads that
+ * got cheaper tasks help the ones that got more expensive ones.
+ */
+class thread_pool {
+public:
+    /**
+     * Creates the pool of worker threads. The thread calling parallel_for
+     * executes the tasks as well, so the pool with zero workers executes
+     * all the tasks on the calling thread.
+     *
+     * @param workers Number of worker threads
+     */
+    explicit thread_pool(std::size_t const workers = default_workers());
+
+    thread_pool(thread_pool&& rhs) = delete;
+    thread_pool(thread_pool const& rhs) = delete;
+
+    thread_pool& operator=(thread_pool&& rhs) = delete;
+    thread_pool& operator=(thread_pool const& rhs) = delete;
+
+    ~thread_pool();
+
+    /**
+     * Gets the number of threads executing the tasks, including the calling one.
+     *
+     * @return Number of threads
+     */
+    [[nodiscard]] std::size_t concurrency() const noexcept {
+        return queues_.size();
+    }
+
+    /**
+     * Executes the tasks with indices [0, count) and waits for all of them to complete.
+     * Calls from multiple threads are serialized.
+     *
+     * @param count Number of tasks
+     * @param task  Function accepting the index of the task
+     *
+     * @throws Rethrows the first exception thrown by the tasks, after all of them complete
+     */
+    void parallel_for(std::size_t const count, std::function<void(std::size_t)> const& task);
+
+    /**
+     * Gets the number of worker threads used by default, so that together
+     * with the calling thread there is one thread per hardware thread.
+     *
+     * @return Default number of worker threads
+     */
+    [[nodiscard]] static std::size_t default_workers() noexcept;
+
+private:
+    /**
+     * struct task_queue
+     *
+     * Represents a queue of task indices owned by one of the threads.
+     */
+    struct task_queue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    void work(std::size_t const queue);
+    [[nodiscard]] bool execute(std::size_t const queue);
+    [[nodiscard]] bool pop(std::size_t const queue, std::size_t& task);
+    [[nodiscard]] bool steal(std::size_t const queue, std::size_t& task);
+
+private:
+    std::vector<std::unique_ptr<task_queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex call_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    std::function<void(std::size_t)> const* task_{ nullptr };
+    std::atomic<std::size_t> pending_{ 0 };
+    std::exception_ptr error_;
+    std::size_t generation_{ 0 };
+    bool stop_{ false };
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_THREAD_POOL_H
\ No newline at end of file
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_TYPE_ID_H
+#define BOOLEVAL_TYPE_ID_H
+
+#include <type_traits>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * Represents the identifier of a type. Identifiers of two types are equal
+ * if and only if the types are the same (ignoring cv-qualifiers).
+ */
+using type_id = void const*;
+
+/**
+ * struct type_tag
+ *
+ * Represents the tag whose address is used as a type identifier.
+ */
+template <typename T>
+struct type_tag {
+    static constexpr char tag{ 0 };
+};
+
+/**
+ * Gets the identifier of the specified type. Unlike comparing std::type_info
+ * objects, comparing identifiers is always a single pointer comparison.
+ *
+ * @return Type identifier
+ */
+template <typename T>
+[[nodiscard]] constexpr type_id type_id_of() noexcept {
+    return &type_tag<std::remove_cv_t<T>>::tag;
+}
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_TYPE_ID_H
@@ -35,6 +35,37 @@ namespace booleval {
 
 namespace token {
 
+namespace {
+
+/**
+ * Splits the expression into tokens and passes them to the function one by one.
+ * Field following another field is preceded by an implicit equality operator.
+ *
+ * @param expression Expression to be tokenized
+ * @param emit       Function accepting the tokens
+ */
+template <typename F>
+void for_each_token(std::string_view const expression, F&& emit) {
+    constexpr auto options =
+        utils::split_options::include_delimiters  |
+        utils::split_options::split_by_whitespace |
+        utils::split_options::allow_quoted_strings;
+
+    auto previous = token_type::unknown;
+    for (auto const& [quoted, index, value] : utils::split_range<options>(expression, parenthesis_delimiters())) {
+        auto const type = quoted ? token_type::field : map_to_token_type(value);
+
+        if (token_type::field == type && token_type::field == previous) {
+            emit(token(token_type::eq, map_to_token_value(token_type::eq)));
+        }
+
+        emit(token(type, value));
+        previous = type;
+    }
+}
+
+} // namespace
+
 tokenizer::tokenizer(std::string_view expression) noexcept
     : expression_(expression) {
 }
@@ -67,32 +98,41 @@ void tokenizer::tokenize() {
     tokens_.clear();
     reset();
 
-    constexpr auto parenthesis_symbols = parenthesis_symbol_expressions();
-    constexpr auto options =
-        utils::split_options::include_delimiters  |
-        utils::split_options::split_by_whitespace |
-        utils::split_options::allow_quoted_strings;
-
-    auto delims = utils::join(std::begin(parenthesis_symbols), std::end(parenthesis_symbols));
-    auto tokens_range = utils::split_range<options>(expression_, delims);
-
-    for (auto const& [quoted, index, value] : tokens_range) {
-        auto type = quoted ? token_type::field : map_to_token_type(value);
+    for_each_token(expression_, [this](token const& token) {
+        tokens_.push_back(token);
+    });
+}
 
-        if (token_type::field == type) {
-            if (!tokens_.empty() && tokens_.back().is(token_type::field)) {
-                tokens_.emplace_back(token_type::eq, map_to_token_value(token_type::eq));
-            }
+std::size_t tokenizer::tokenize(std::string_view expression, token* tokens, std::size_t const capacity) noexcept {
+    std::size_t count{ 0 };
+    for_each_token(expression, [&](token const& token) {
+        if (count < capacity) {
+            tokens[count] = token;
         }
-
-        tokens_.emplace_back(type, value);
-    }
+        ++count;
+    });
+    return count;
 }
 
 void tokenizer::reset() noexcept {
     current_token_index_ = 0;
 }
 
+std::string tokenizer::canonical_form() const {
+    std::string canonical;
+    for (auto const& token : tokens_) {
+        canonical += static_cast<char>('a' + static_cast<uint8_t>(token.type()));
+
+        // Length prefix keeps fields containing delimiters unambiguous
+        if (token.is(token_type::field)) {
+            canonical += std::to_string(token.value().size());
+            canonical += ':';
+            canonical += token.value();
+        }
+    }
+    return canonical;
+}
+
 } // token
 
 } // booleval
@@ -0,0 +1,676 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <algorithm>
+#include <booleval/tree/column_kernels.hpp>
+#include <booleval/utils/instruction_set.hpp>
+#include "utils/target.hpp"
+
+namespace booleval {
+
+namespace tree {
+
+namespace {
+
+constexpr std::size_t bits_per_word{ 64 };
+constexpr std::size_t count_of_relations{ 6 };
+
+template <typename T>
+using compare_fn = void (*)(T const*, std::size_t, T, uint64_t*);
+
+template <typename T>
+using compare_table = std::array<compare_fn<T>, count_of_relations>;
+
+using combine_fn = void (*)(uint64_t*, uint64_t const*, std::size_t);
+
+/**
+ * struct kernel_table
+ *
+ * Represents the set of kernels implemented by using the same instruction set.
+ * Comparison kernels are indexed by relational operators, starting from eq.
+ */
+struct kernel_table {
+    compare_table<int32_t> int32;
+    compare_table<uint32_t> uint32;
+    compare_table<int64_t> int64;
+    compare_table<uint64_t> uint64;
+    compare_table<float> float32;
+    compare_table<double> float64;
+    combine_fn and_words;
+    combine_fn or_words;
+};
+
+template <token::token_type R, typename T>
+[[nodiscard]] constexpr bool relate(T const lhs, T const rhs) noexcept {
+    if constexpr (token::token_type::eq == R) {
+        return lhs == rhs;
+    } else if constexpr (token::token_type::neq == R) {
+        return lhs != rhs;
+    } else if constexpr (token::token_type::gt == R) {
+        return lhs > rhs;
+    } else if constexpr (token::token_type::lt == R) {
+        return lhs < rhs;
+    } else if constexpr (token::token_type::geq == R) {
+        return lhs >= rhs;
+    } else {
+        return lhs <= rhs;
+    }
+}
+
+template <token::token_type R, typename T>
+void compare_scalar(T const* values, std::size_t const count, T const literal, uint64_t* result) noexcept {
+    for (std::size_t row = 0, i = 0; row < count; row += bits_per_word, ++i) {
+        auto const size = std::min(bits_per_word, count - row);
+
+        uint64_t bits{ 0 };
+        for (std::size_t j = 0; j < size; ++j) {
+            bits |= uint64_t{ relate<R>(values[row + j], literal) } << j;
+        }
+
+        result[i] = bits;
+    }
+}
+
+/**
+ * struct scalar_isa
+ *
+ * Represents the kernels implemented without any SIMD instructions.
+ */
+struct scalar_isa {
+    template <token::token_type R, typename T>
+    static void compare(T const* values, std::size_t const count, T const literal, uint64_t* result) noexcept {
+        compare_scalar<R>(values, count, literal, result);
+    }
+
+    static void and_words(uint64_t* result, uint64_t const* other, std::size_t const count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            result[i] &= other[i];
+        }
+    }
+
+    static void or_words(uint64_t* result, uint64_t const* other, std::size_t const count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            result[i] |= other[i];
+        }
+    }
+};
+
+#if defined(BOOLEVAL_X86_KERNELS)
+
+/**
+ * Integer vectors are compared by using only equality and signed greater-than
+ * comparisons, while the other relational operators are derived from them by
+ * swapping the operands and inverting the resulting mask.
+ */
+template <token::token_type R, typename Traits, typename V>
+[[nodiscard]] BOOLEVAL_TARGET_SSE42 uint32_t compare_integers_sse42(V const lhs, V const rhs) noexcept {
+    constexpr uint32_t all{ (uint32_t{ 1 } << Traits::lanes) - 1 };
+
+    if constexpr (token::token_type::eq == R) {
+        return Traits::movemask(Traits::cmpeq(lhs, rhs));
+    } else if constexpr (token::token_type::neq == R) {
+        return Traits::movemask(Traits::cmpeq(lhs, rhs)) ^ all;
+    } else if constexpr (token::token_type::gt == R) {
+        return Traits::movemask(Traits::cmpgt(lhs, rhs));
+    } else if constexpr (token::token_type::lt == R) {
+        return Traits::movemask(Traits::cmpgt(rhs, lhs));
+    } else if constexpr (token::token_type::geq == R) {
+        return Traits::movemask(Traits::cmpgt(rhs, lhs)) ^ all;
+    } else {
+        return Traits::movemask(Traits::cmpgt(lhs, rhs)) ^ all;
+    }
+}
+
+template <typename T>
+struct sse42_traits;
+
+template <>
+struct sse42_traits<int32_t> {
+    using vector = __m128i;
+    static constexpr std::size_t lanes{ 4 };
+
+    BOOLEVAL_TARGET_SSE42 static vector load(int32_t const* values) noexcept {
+        return _mm_loadu_si128(reinterpret_cast<vector const*>(values));
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector set1(int32_t const value) noexcept {
+        return _mm_set1_epi32(value);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector cmpeq(vector const lhs, vector const rhs) noexcept {
+        return _mm_cmpeq_epi32(lhs, rhs);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector cmpgt(vector const lhs, vector const rhs) noexcept {
+        return _mm_cmpgt_epi32(lhs, rhs);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static uint32_t movemask(vector const mask) noexcept {
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+    }
+
+    template <token::token_type R>
+    BOOLEVAL_TARGET_SSE42 static uint32_t compare(vector const lhs, vector const rhs) noexcept {
+        return compare_integers_sse42<R, sse42_traits>(lhs, rhs);
+    }
+};
+
+template <>
+struct sse42_traits<uint32_t> : sse42_traits<int32_t> {
+    // Unsigned values are compared as signed ones after flipping their sign bits
+    BOOLEVAL_TARGET_SSE42 static vector load(uint32_t const* values) noexcept {
+        return _mm_xor_si128(sse42_traits<int32_t>::load(reinterpret_cast<int32_t const*>(values)), _mm_set1_epi32(INT32_MIN));
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector set1(uint32_t const value) noexcept {
+        return _mm_set1_epi32(static_cast<int32_t>(value ^ 0x80000000U));
+    }
+};
+
+template <>
+struct sse42_traits<int64_t> {
+    using vector = __m128i;
+    static constexpr std::size_t lanes{ 2 };
+
+    BOOLEVAL_TARGET_SSE42 static vector load(int64_t const* values) noexcept {
+        return _mm_loadu_si128(reinterpret_cast<vector const*>(values));
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector set1(int64_t const value) noexcept {
+        return _mm_set1_epi64x(value);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector cmpeq(vector const lhs, vector const rhs) noexcept {
+        return _mm_cmpeq_epi64(lhs, rhs);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector cmpgt(vector const lhs, vector const rhs) noexcept {
+        return _mm_cmpgt_epi64(lhs, rhs);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static uint32_t movemask(vector const mask) noexcept {
+        return static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(mask)));
+    }
+
+    template <token::token_type R>
+    BOOLEVAL_TARGET_SSE42 static uint32_t compare(vector const lhs, vector const rhs) noexcept {
+        return compare_integers_sse42<R, sse42_traits>(lhs, rhs);
+    }
+};
+
+template <>
+struct sse42_traits<uint64_t> : sse42_traits<int64_t> {
+    BOOLEVAL_TARGET_SSE42 static vector load(uint64_t const* values) noexcept {
+        return _mm_xor_si128(sse42_traits<int64_t>::load(reinterpret_cast<int64_t const*>(values)), _mm_set1_epi64x(INT64_MIN));
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector set1(uint64_t const value) noexcept {
+        return _mm_set1_epi64x(static_cast<int64_t>(value ^ 0x8000000000000000ULL));
+    }
+};
+
+template <>
+struct sse42_traits<float> {
+    using vector = __m128;
+    static constexpr std::size_t lanes{ 4 };
+
+    BOOLEVAL_TARGET_SSE42 static vector load(float const* values) noexcept {
+        return _mm_loadu_ps(values);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector set1(float const value) noexcept {
+        return _mm_set1_ps(value);
+    }
+
+    template <token::token_type R>
+    BOOLEVAL_TARGET_SSE42 static uint32_t compare(vector const lhs, vector const rhs) noexcept {
+        if constexpr (token::token_type::eq == R) {
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpeq_ps(lhs, rhs)));
+        } else if constexpr (token::token_type::neq == R) {
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpneq_ps(lhs, rhs)));
+        } else if constexpr (token::token_type::gt == R) {
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpgt_ps(lhs, rhs)));
+        } else if constexpr (token::token_type::lt == R) {
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(lhs, rhs)));
+        } else if constexpr (token::token_type::geq == R) {
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(lhs, rhs)));
+        } else {
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(lhs, rhs)));
+        }
+    }
+};
+
+template <>
+struct sse42_traits<double> {
+    using vector = __m128d;
+    static constexpr std::size_t lanes{ 2 };
+
+    BOOLEVAL_TARGET_SSE42 static vector load(double const* values) noexcept {
+        return _mm_loadu_pd(values);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static vector set1(double const value) noexcept {
+        return _mm_set1_pd(value);
+    }
+
+    template <token::token_type R>
+    BOOLEVAL_TARGET_SSE42 static uint32_t compare(vector const lhs, vector const rhs) noexcept {
+        if constexpr (token::token_type::eq == R) {
+            return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpeq_pd(lhs, rhs)));
+        } else if constexpr (token::token_type::neq == R) {
+            return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpneq_pd(lhs, rhs)));
+        } else if constexpr (token::token_type::gt == R) {
+            return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpgt_pd(lhs, rhs)));
+        } else if constexpr (token::token_type::lt == R) {
+            return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmplt_pd(lhs, rhs)));
+        } else if constexpr (token::token_type::geq == R) {
+            return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmpge_pd(lhs, rhs)));
+        } else {
+            return static_cast<uint32_t>(_mm_movemask_pd(_mm_cmple_pd(lhs, rhs)));
+        }
+    }
+};
+
+/**
+ * struct sse42_isa
+ *
+ * Represents the kernels implemented by using SSE4.2 instructions.
+ */
+struct sse42_isa {
+    template <token::token_type R, typename T>
+    BOOLEVAL_TARGET_SSE42 static void compare(T const* values, std::size_t const count, T const literal, uint64_t* result) noexcept {
+        using traits = sse42_traits<T>;
+
+        auto const rhs = traits::set1(literal);
+
+        std::size_t row{ 0 };
+        std::size_t word{ 0 };
+        for (; row + bits_per_word <= count; row += bits_per_word, ++word) {
+            uint64_t bits{ 0 };
+            for (std::size_t j = 0; j < bits_per_word; j += traits::lanes) {
+                bits |= uint64_t{ traits::template compare<R>(traits::load(values + row + j), rhs) } << j;
+            }
+            result[word] = bits;
+        }
+
+        compare_scalar<R>(values + row, count - row, literal, result + word);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static void and_words(uint64_t* result, uint64_t const* other, std::size_t const count) noexcept {
+        std::size_t i{ 0 };
+        for (; i + 2 <= count; i += 2) {
+            auto const lhs = _mm_loadu_si128(reinterpret_cast<__m128i const*>(result + i));
+            auto const rhs = _mm_loadu_si128(reinterpret_cast<__m128i const*>(other + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm_and_si128(lhs, rhs));
+        }
+        scalar_isa::and_words(result + i, other + i, count - i);
+    }
+
+    BOOLEVAL_TARGET_SSE42 static void or_words(uint64_t* result, uint64_t const* other, std::size_t const count) noexcept {
+        std::size_t i{ 0 };
+        for (; i + 2 <= count; i += 2) {
+            auto const lhs = _mm_loadu_si128(reinterpret_cast<__m128i const*>(result + i));
+            auto const rhs = _mm_loadu_si128(reinterpret_cast<__m128i const*>(other + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm_or_si128(lhs, rhs));
+        }
+        scalar_isa::or_words(result + i, other + i, count - i);
+    }
+};
+
+template <token::token_type R, typename Traits, typename V>
+[[nodiscard]] BOOLEVAL_TARGET_AVX2 uint32_t compare_integers_avx2(V const lhs, V const rhs) noexcept {
+    constexpr uint32_t all{ (uint32_t{ 1 } << Traits::lanes) - 1 };
+
+    if constexpr (token::token_type::eq == R) {
+        return Traits::movemask(Traits::cmpeq(lhs, rhs));
+    } else if constexpr (token::token_type::neq == R) {
+        return Traits::movemask(Traits::cmpeq(lhs, rhs)) ^ all;
+    } else if constexpr (token::token_type::gt == R) {
+        return Traits::movemask(Traits::cmpgt(lhs, rhs));
+    } else if constexpr (token::token_type::lt == R) {
+        return Traits::movemask(Traits::cmpgt(rhs, lhs));
+    } else if constexpr (token::token_type::geq == R) {
+        return Traits::movemask(Traits::cmpgt(rhs, lhs)) ^ all;
+    } else {
+        return Traits::movemask(Traits::cmpgt(lhs, rhs)) ^ all;
+    }
+}
+
+template <typename T>
+struct avx2_traits;
+
+template <>
+struct avx2_traits<int32_t> {
+    using vector = __m256i;
+    static constexpr std::size_t lanes{ 8 };
+
+    BOOLEVAL_TARGET_AVX2 static vector load(int32_t const* values) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<vector const*>(values));
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector set1(int32_t const value) noexcept {
+        return _mm256_set1_epi32(value);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector cmpeq(vector const lhs, vector const rhs) noexcept {
+        return _mm256_cmpeq_epi32(lhs, rhs);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector cmpgt(vector const lhs, vector const rhs) noexcept {
+        return _mm256_cmpgt_epi32(lhs, rhs);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static uint32_t movemask(vector const mask) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+    }
+
+    template <token::token_type R>
+    BOOLEVAL_TARGET_AVX2 static uint32_t compare(vector const lhs, vector const rhs) noexcept {
+        return compare_integers_avx2<R, avx2_traits>(lhs, rhs);
+    }
+};
+
+template <>
+struct avx2_traits<uint32_t> : avx2_traits<int32_t> {
+    BOOLEVAL_TARGET_AVX2 static vector load(uint32_t const* values) noexcept {
+        return _mm256_xor_si256(avx2_traits<int32_t>::load(reinterpret_cast<int32_t const*>(values)), _mm256_set1_epi32(INT32_MIN));
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector set1(uint32_t const value) noexcept {
+        return _mm256_set1_epi32(static_cast<int32_t>(value ^ 0x80000000U));
+    }
+};
+
+template <>
+struct avx2_traits<int64_t> {
+    using vector = __m256i;
+    static constexpr std::size_t lanes{ 4 };
+
+    BOOLEVAL_TARGET_AVX2 static vector load(int64_t const* values) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<vector const*>(values));
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector set1(int64_t const value) noexcept {
+        return _mm256_set1_epi64x(value);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector cmpeq(vector const lhs, vector const rhs) noexcept {
+        return _mm256_cmpeq_epi64(lhs, rhs);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector cmpgt(vector const lhs, vector const rhs) noexcept {
+        return _mm256_cmpgt_epi64(lhs, rhs);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static uint32_t movemask(vector const mask) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+    }
+
+    template <token::token_type R>
+    BOOLEVAL_TARGET_AVX2 static uint32_t compare(vector const lhs, vector const rhs) noexcept {
+        return compare_integers_avx2<R, avx2_traits>(lhs, rhs);
+    }
+};
+
+template <>
+struct avx2_traits<uint64_t> : avx2_traits<int64_t> {
+    BOOLEVAL_TARGET_AVX2 static vector load(uint64_t const* values) noexcept {
+        return _mm256_xor_si256(avx2_traits<int64_t>::load(reinterpret_cast<int64_t const*>(values)), _mm256_set1_epi64x(INT64_MIN));
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector set1(uint64_t const value) noexcept {
+        return _mm256_set1_epi64x(static_cast<int64_t>(value ^ 0x8000000000000000ULL));
+    }
+};
+
+template <>
+struct avx2_traits<float> {
+    using vector = __m256;
+    static constexpr std::size_t lanes{ 8 };
+
+    BOOLEVAL_TARGET_AVX2 static vector load(float const* values) noexcept {
+        return _mm256_loadu_ps(values);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector set1(float const value) noexcept {
+        return _mm256_set1_ps(value);
+    }
+
+    template <token::token_type R>
+    BOOLEVAL_TARGET_AVX2 static uint32_t compare(vector const lhs, vector const rhs) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, predicate<R>())));
+    }
+
+    template <token::token_type R>
+    static constexpr int predicate() noexcept {
+        if constexpr (token::token_type::eq == R) {
+            return _CMP_EQ_OQ;
+        } else if constexpr (token::token_type::neq == R) {
+            return _CMP_NEQ_UQ;
+        } else if constexpr (token::token_type::gt == R) {
+            return _CMP_GT_OQ;
+        } else if constexpr (token::token_type::lt == R) {
+            return _CMP_LT_OQ;
+        } else if constexpr (token::token_type::geq == R) {
+            return _CMP_GE_OQ;
+        } else {
+            return _CMP_LE_OQ;
+        }
+    }
+};
+
+template <>
+struct avx2_traits<double> {
+    using vector = __m256d;
+    static constexpr std::size_t lanes{ 4 };
+
+    BOOLEVAL_TARGET_AVX2 static vector load(double const* values) noexcept {
+        return _mm256_loadu_pd(values);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static vector set1(double const value) noexcept {
+        return _mm256_set1_pd(value);
+    }
+
+    template <token::token_type R>
+    BOOLEVAL_TARGET_AVX2 static uint32_t compare(vector const lhs, vector const rhs) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, avx2_traits<float>::predicate<R>())));
+    }
+};
+
+/**
+ * struct avx2_isa
+ *
+ * Represents the kernels implemented by using AVX2 instructions.
+ */
+struct avx2_isa {
+    template <token::token_type R, typename T>
+    BOOLEVAL_TARGET_AVX2 static void compare(T const* values, std::size_t const count, T const literal, uint64_t* result) noexcept {
+        using traits = avx2_traits<T>;
+
+        auto const rhs = traits::set1(literal);
+
+        std::size_t row{ 0 };
+        std::size_t word{ 0 };
+        for (; row + bits_per_word <= count; row += bits_per_word, ++word) {
+            uint64_t bits{ 0 };
+            for (std::size_t j = 0; j < bits_per_word; j += traits::lanes) {
+                bits |= uint64_t{ traits::template compare<R>(traits::load(values + row + j), rhs) } << j;
+            }
+            result[word] = bits;
+        }
+
+        compare_scalar<R>(values + row, count - row, literal, result + word);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static void and_words(uint64_t* result, uint64_t const* other, std::size_t const count) noexcept {
+        std::size_t i{ 0 };
+        for (; i + 4 <= count; i += 4) {
+            auto const lhs = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(result + i));
+            auto const rhs = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(other + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_and_si256(lhs, rhs));
+        }
+        scalar_isa::and_words(result + i, other + i, count - i);
+    }
+
+    BOOLEVAL_TARGET_AVX2 static void or_words(uint64_t* result, uint64_t const* other, std::size_t const count) noexcept {
+        std::size_t i{ 0 };
+        for (; i + 4 <= count; i += 4) {
+            auto const lhs = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(result + i));
+            auto const rhs = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(other + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), _mm256_or_si256(lhs, rhs));
+        }
+        scalar_isa::or_words(result + i, other + i, count - i);
+    }
+};
+
+#endif // BOOLEVAL_X86_KERNELS
+
+/**
+ * Gets the slot of the relational operator in the table of comparison kernels.
+ */
+[[nodiscard]] constexpr std::size_t relation_slot(token::token_type const relation) noexcept {
+    return static_cast<std::size_t>(relation) - static_cast<std::size_t>(token::token_type::eq);
+}
+
+// Kernels are looked up by the relational operator, so the operators have to
+// keep their order and stay contiguous in token_type
+static_assert(0 == relation_slot(token::token_type::eq),  "eq must be in the first slot");
+static_assert(1 == relation_slot(token::token_type::neq), "neq must be in the second slot");
+static_assert(2 == relation_slot(token::token_type::gt),  "gt must be in the third slot");
+static_assert(3 == relation_slot(token::token_type::lt),  "lt must be in the fourth slot");
+static_assert(4 == relation_slot(token::token_type::geq), "geq must be in the fifth slot");
+static_assert(5 == relation_slot(token::token_type::leq), "leq must be in the sixth slot");
+static_assert(count_of_relations == relation_slot(token::token_type::leq) + 1, "Table must cover all relational operators");
+
+template <typename Isa, typename T>
+[[nodiscard]] constexpr compare_table<T> make_compare_table() noexcept {
+    return {{
+        &Isa::template compare<token::token_type::eq,  T>,
+        &Isa::template compare<token::token_type::neq, T>,
+        &Isa::template compare<token::token_type::gt,  T>,
+        &Isa::template compare<token::token_type::lt,  T>,
+        &Isa::template compare<token::token_type::geq, T>,
+        &Isa::template compare<token::token_type::leq, T>
+    }};
+}
+
+template <typename Isa>
+[[nodiscard]] constexpr kernel_table make_kernel_table() noexcept {
+    return {
+        make_compare_table<Isa, int32_t>(),
+        make_compare_table<Isa, uint32_t>(),
+        make_compare_table<Isa, int64_t>(),
+        make_compare_table<Isa, uint64_t>(),
+        make_compare_table<Isa, float>(),
+        make_compare_table<Isa, double>(),
+        &Isa::and_words,
+        &Isa::or_words
+    };
+}
+
+constexpr kernel_table scalar_kernels{ make_kernel_table<scalar_isa>() };
+
+#if defined(BOOLEVAL_X86_KERNELS)
+constexpr kernel_table sse42_kernels{ make_kernel_table<sse42_isa>() };
+constexpr kernel_table avx2_kernels{ make_kernel_table<avx2_isa>() };
+#endif
+
+[[nodiscard]] kernel_table const* kernels_for(utils::instruction_set const set) noexcept {
+    switch (set) {
+#if defined(BOOLEVAL_X86_KERNELS)
+    case utils::instruction_set::avx2:
+        return &avx2_kernels;
+
+    case utils::instruction_set::sse42:
+        return &sse42_kernels;
+#endif
+
+    default:
+        return &scalar_kernels;
+    }
+}
+
+[[nodiscard]] kernel_table const* active_kernels() noexcept {
+    return kernels_for(utils::active_instruction_set());
+}
+
+template <typename T>
+void dispatch_compare(compare_table<T> const& table,
+                      T const* values,
+                      std::size_t const count,
+                      T const literal,
+                      token::token_type const relation,
+                      uint64_t* result) noexcept {
+    auto const index = relation_slot(relation);
+    if (index < count_of_relations) {
+        table[index](values, count, literal, result);
+    } else {
+        std::fill(result, result + (count + bits_per_word - 1) / bits_per_word, 0);
+    }
+}
+
+} // namespace
+
+void compare_contiguous(int32_t const* values, std::size_t const count, int32_t const literal, token::token_type const relation, uint64_t* result) noexcept {
+    dispatch_compare(active_kernels()->int32, values, count, literal, relation, result);
+}
+
+void compare_contiguous(uint32_t const* values, std::size_t const count, uint32_t const literal, token::token_type const relation, uint64_t* result) noexcept {
+    dispatch_compare(active_kernels()->uint32, values, count, literal, relation, result);
+}
+
+void compare_contiguous(int64_t const* values, std::size_t const count, int64_t const literal, token::token_type const relation, uint64_t* result) noexcept {
+    dispatch_compare(active_kernels()->int64, values, count, literal, relation, result);
+}
+
+void compare_contiguous(uint64_t const* values, std::size_t const count, uint64_t const literal, token::token_type const relation, uint64_t* result) noexcept {
+    dispatch_compare(active_kernels()->uint64, values, count, literal, relation, result);
+}
+
+void compare_contiguous(float const* values, std::size_t const count, float const literal, token::token_type const relation, uint64_t* result) noexcept {
+    dispatch_compare(active_kernels()->float32, values, count, literal, relation, result);
+}
+
+void compare_contiguous(double const* values, std::size_t const count, double const literal, token::token_type const relation, uint64_t* result) noexcept {
+    dispatch_compare(active_kernels()->float64, values, count, literal, relation, result);
+}
+
+void and_words(uint64_t* result, uint64_t const* other, std::size_t const count) noexcept {
+    active_kernels()->and_words(result, other, count);
+}
+
+void or_words(uint64_t* result, uint64_t const* other, std::size_t const count) noexcept {
+    active_kernels()->or_words(result, other, count);
+}
+
+} // tree
+
+} // booleval
\ No newline at end of file
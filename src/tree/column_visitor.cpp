@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <booleval/exceptions.hpp>
+#include <booleval/utils/any_value.hpp>
+#include <booleval/tree/comparison.hpp>
+#include <booleval/tree/column_kernels.hpp>
+#include <booleval/tree/column_visitor.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+namespace {
+
+constexpr auto bits_per_word{ utils::bitmap::bits_per_word };
+
+/**
+ * Gets the mask of the bits representing rows within the word.
+ *
+ * @param count Number of rows in the word
+ *
+ * @return Mask with the lowest count bits set
+ */
+[[nodiscard]] constexpr uint64_t word_mask(std::size_t const count) noexcept {
+    return count < bits_per_word ? (uint64_t{ 1 } << count) - 1 : ~uint64_t{ 0 };
+}
+
+/**
+ * Checks whether the words have the same value for all the rows.
+ *
+ * @param words Words containing the result for the rows
+ * @param count Number of rows
+ * @param value Value to check for
+ *
+ * @return True if all the rows have the specified value, otherwise false
+ */
+[[nodiscard]] bool all_rows(uint64_t const* words, std::size_t const count, bool const value) noexcept {
+    for (std::size_t row = 0, i = 0; row < count; row += bits_per_word, ++i) {
+        auto const mask = word_mask(std::min(bits_per_word, count - row));
+        if (words[i] != (value ? mask : 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Sets all the rows to the same value.
+ *
+ * @param words Words containing the result for the rows
+ * @param count Number of rows
+ * @param value Value to set
+ */
+void fill_rows(uint64_t* words, std::size_t const count, bool const value) noexcept {
+    for (std::size_t row = 0, i = 0; row < count; row += bits_per_word, ++i) {
+        words[i] = value ? word_mask(std::min(bits_per_word, count - row)) : 0;
+    }
+}
+
+/**
+ * Converts the literal to the type of the column's values if it can be represented
+ * exactly, so the values can be compared to it natively.
+ *
+ * @param literal Literal to convert
+ * @param exact   Converted literal
+ *
+ * @return True if the literal can be represented exactly, otherwise false
+ */
+template <typename T, typename L>
+[[nodiscard]] bool represent(L const literal, T& exact) noexcept {
+    auto const lower = utils::compare_arithmetic(literal, std::numeric_limits<T>::lowest());
+    auto const upper = utils::compare_arithmetic(literal, std::numeric_limits<T>::max());
+
+    auto const above_lower = utils::comparison_result::greater == lower ||
+                             utils::comparison_result::equal   == lower;
+    auto const below_upper = utils::comparison_result::less  == upper ||
+                             utils::comparison_result::equal == upper;
+
+    if (!above_lower || !below_upper) {
+        return false;
+    }
+
+    exact = static_cast<T>(literal);
+    return utils::comparison_result::equal == utils::compare_arithmetic(exact, literal);
+}
+
+/**
+ * Compares the values of the column to the literal.
+ *
+ * @param values  Column of values
+ * @param offset  Index of the first row to compare
+ * @param count   Number of rows to compare
+ * @param literal Literal to compare to
+ * @param func    Comparison function
+ * @param result  Words with i-th bit set if the value of i-th row satisfies the comparison
+ */
+template <typename T, typename L, typename F>
+void compare_values(column const& values,
+                    std::size_t const offset,
+                    std::size_t const count,
+                    L const& literal,
+                    F&& func,
+                    uint64_t* result) {
+    auto const stride = values.stride();
+    auto const first  = static_cast<char const*>(values.data()) + offset * stride;
+
+    for (std::size_t row = 0, i = 0; row < count; row += bits_per_word, ++i) {
+        auto const size = std::min(bits_per_word, count - row);
+
+        uint64_t bits{ 0 };
+        if (sizeof(T) == stride) {
+            auto const contiguous = reinterpret_cast<T const*>(first) + row;
+            for (std::size_t j = 0; j < size; ++j) {
+                bits |= uint64_t{ func(contiguous[j], literal) } << j;
+            }
+        } else {
+            for (std::size_t j = 0; j < size; ++j) {
+                auto const& value = *reinterpret_cast<T const*>(first + (row + j) * stride);
+                bits |= uint64_t{ func(value, literal) } << j;
+            }
+        }
+
+        result[i] = bits;
+    }
+}
+
+/**
+ * Compares the values of the column to the literal. String columns are compared to the
+ * literal as it is written in the expression, while arithmetic ones to its parsed value.
+ *
+ * @param values   Column of values
+ * @param offset   Index of the first row to compare
+ * @param count    Number of rows to compare
+ * @param literal  Leaf node containing the literal
+ * @param parsed   Parsed literal (empty if it is not parsed)
+ * @param relation Relational operator
+ * @param func     Comparison function matching the relational operator
+ * @param result   Words with i-th bit set if the value of i-th row satisfies the comparison
+ */
+template <typename F>
+void compare_column(column const& values,
+                    std::size_t const offset,
+                    std::size_t const count,
+                    tree_node const& literal,
+                    utils::any_value const& parsed,
+                    token::token_type const relation,
+                    F&& func,
+                    uint64_t* result) {
+    values.visit([&](auto const* type) {
+        using T = std::remove_cv_t<std::remove_pointer_t<decltype(type)>>;
+
+        if constexpr (std::is_arithmetic_v<T>) {
+            auto const number = parsed.empty()
+                ? utils::parse_value(literal.token.value())
+                : parsed;
+
+            number.visit([&](auto const& value) {
+                using L = std::decay_t<decltype(value)>;
+
+                if constexpr (std::is_arithmetic_v<L>) {
+                    T exact{};
+                    if (represent(value, exact)) {
+                        if constexpr (has_column_kernel_v<T>) {
+                            if (sizeof(T) == values.stride()) {
+                                auto const first = static_cast<T const*>(values.data()) + offset;
+                                compare_contiguous(first, count, exact, relation, result);
+                                return;
+                            }
+                        }
+                        compare_values<T>(values, offset, count, exact, func, result);
+                    } else {
+                        compare_values<T>(values, offset, count, value,
+                            [relation](T const lhs, L const rhs) {
+                                return satisfies(relation, utils::compare_arithmetic(lhs, rhs));
+                            },
+                            result
+                        );
+                    }
+                } else {
+                    fill_rows(result, count, satisfies(relation, utils::comparison_result::unordered));
+                }
+            });
+        } else {
+            compare_values<T>(values, offset, count, literal.token.value(), func, result);
+        }
+    });
+}
+
+} // namespace
+
+void column_visitor::visit(expression_tree const& tree, column_map const& columns, utils::bitmap& result) const {
+    auto const rows = columns.empty() ? 0 : std::begin(columns)->second.size();
+    for (auto const& [name, values] : columns) {
+        if (values.size() != rows) {
+            throw column_size_mismatch(name);
+        }
+    }
+
+    result.resize(rows);
+
+    auto const root = tree.root();
+    if (nullptr == root) {
+        return;
+    }
+
+    std::array<uint64_t, words_per_chunk> words;
+    for (std::size_t offset = 0; offset < rows; offset += rows_per_chunk) {
+        auto const count = std::min(rows_per_chunk, rows - offset);
+        visit(tree, *root, columns, offset, count, words.data());
+
+        for (std::size_t row = 0, i = 0; row < count; row += bits_per_word, ++i) {
+            result.word((offset + row) / bits_per_word, words[i]);
+        }
+    }
+}
+
+void column_visitor::visit(expression_tree const& tree,
+                           tree_node const& node,
+                           column_map const& columns,
+                           std::size_t const offset,
+                           std::size_t const count,
+                           uint64_t* result) const {
+    if (null_node == node.left || null_node == node.right) {
+        fill_rows(result, count, false);
+        return;
+    }
+
+    switch (node.token.type()) {
+    case token::token_type::logical_and:
+    case token::token_type::logical_or: {
+        auto const is_and = node.token.is(token::token_type::logical_and);
+
+        visit(tree, tree.node(node.left), columns, offset, count, result);
+        if (evaluation_mode::short_circuit == mode_ && all_rows(result, count, !is_and)) {
+            return;
+        }
+
+        std::array<uint64_t, words_per_chunk> right;
+        visit(tree, tree.node(node.right), columns, offset, count, right.data());
+
+        auto const words = (count + bits_per_word - 1) / bits_per_word;
+        if (is_and) {
+            and_words(result, right.data(), words);
+        } else {
+            or_words(result, right.data(), words);
+        }
+        break;
+    }
+
+    case token::token_type::eq:
+    case token::token_type::neq:
+    case token::token_type::gt:
+    case token::token_type::lt:
+    case token::token_type::geq:
+    case token::token_type::leq:
+        visit_relational(tree, node, columns, offset, count, result);
+        break;
+
+    default:
+        fill_rows(result, count, false);
+        break;
+    }
+}
+
+void column_visitor::visit_relational(expression_tree const& tree,
+                                      tree_node const& node,
+                                      column_map const& columns,
+                                      std::size_t const offset,
+                                      std::size_t const count,
+                                      uint64_t* result) const {
+    auto const name = tree.node(node.left).token.value();
+
+    auto const iter = columns.find(name);
+    if (iter == std::end(columns)) {
+        throw field_not_found(name);
+    }
+
+    auto const& values   = iter->second;
+    auto const& literal  = tree.node(node.right);
+    auto const& parsed   = tree.literal(literal);
+    auto const  relation = node.token.type();
+
+    switch (relation) {
+    case token::token_type::eq:
+        compare_column(values, offset, count, literal, parsed, relation, std::equal_to<>(), result);
+        break;
+
+    case token::token_type::neq:
+        compare_column(values, offset, count, literal, parsed, relation, std::not_equal_to<>(), result);
+        break;
+
+    case token::token_type::gt:
+        compare_column(values, offset, count, literal, parsed, relation, std::greater<>(), result);
+        break;
+
+    case token::token_type::lt:
+        compare_column(values, offset, count, literal, parsed, relation, std::less<>(), result);
+        break;
+
+    case token::token_type::geq:
+        compare_column(values, offset, count, literal, parsed, relation, std::greater_equal<>(), result);
+        break;
+
+    case token::token_type::leq:
+        compare_column(values, offset, count, literal, parsed, relation, std::less_equal<>(), result);
+        break;
+
+    default:
+        fill_rows(result, count, false);
+        break;
+    }
+}
+
+} // tree
+
+} // booleval
\ No newline at end of file
@@ -34,27 +34,57 @@ namespace booleval {
 
 namespace tree {
 
-std::shared_ptr<tree::tree_node> expression_tree::root() noexcept {
-    return root_;
+tree_node const* expression_tree::root() const noexcept {
+    if (null_node == root_) {
+        return nullptr;
+    }
+    return &nodes_[root_];
+}
+
+tree_node* expression_tree::root() noexcept {
+    if (null_node == root_) {
+        return nullptr;
+    }
+    return &nodes_[root_];
+}
+
+void expression_tree::root(node_index const index) noexcept {
+    root_ = index;
+}
+
+node_index expression_tree::add_node(tree_node node) {
+    nodes_.push_back(std::move(node));
+    return static_cast<node_index>(nodes_.size() - 1);
+}
+
+void expression_tree::clear() noexcept {
+    nodes_.clear();
+    literals_.clear();
+    root_ = null_node;
 }
 
 bool expression_tree::build(std::string_view expression) {
+    clear();
+
     tokenizer_.reset();
     tokenizer_.expression(expression);
     tokenizer_.tokenize();
 
     root_ = parse_expression();
-    if (nullptr == root_) {
+    if (null_node == root_) {
+        clear();
         return false;
     } else if (tokenizer_.has_tokens()) {
-        root_ = nullptr;
+        clear();
         return false;
     }
 
+    nodes_.shrink_to_fit();
+    literals_.shrink_to_fit();
     return true;
 }
 
-std::shared_ptr<tree::tree_node> expression_tree::parse_expression() {
+node_index expression_tree::parse_expression() {
     auto left = parse_and_operation();
 
     auto const is_relational_operator =
@@ -69,7 +99,7 @@ std::shared_ptr<tree::tree_node> expression_tree::parse_expression() {
         );
 
     if (is_relational_operator) {
-        return nullptr;
+        return null_node;
     }
 
     if (tokenizer_.has_tokens() && tokenizer_.weak_next_token().is_not(token::token_type::logical_or)) {
@@ -78,50 +108,50 @@ std::shared_ptr<tree::tree_node> expression_tree::parse_expression() {
 
     while (tokenizer_.has_tokens() && tokenizer_.weak_next_token().is(token::token_type::logical_or)) {
         tokenizer_.pass_token();
-        auto logical_or = std::make_shared<tree::tree_node>(token::token_type::logical_or);
+        auto logical_or = add_node(token::token_type::logical_or);
 
         auto right = parse_and_operation();
-        if (nullptr == right) {
-            return nullptr;
+        if (null_node == right) {
+            return null_node;
         }
 
-        logical_or->left  = left;
-        logical_or->right = right;
+        nodes_[logical_or].left  = left;
+        nodes_[logical_or].right = right;
         left = logical_or;
     }
 
     return left;
 }
 
-std::shared_ptr<tree::tree_node> expression_tree::parse_and_operation() {
+node_index expression_tree::parse_and_operation() {
     auto left = parse_parentheses();
-    if (nullptr == left) {
+    if (null_node == left) {
         left = parse_relational_operation();
     }
 
     while (tokenizer_.has_tokens() && tokenizer_.weak_next_token().is(token::token_type::logical_and)) {
         tokenizer_.pass_token();
 
-        auto logical_and = std::make_shared<tree::tree_node>(token::token_type::logical_and);
+        auto logical_and = add_node(token::token_type::logical_and);
 
         auto right = parse_parentheses();
-        if (nullptr == right) {
+        if (null_node == right) {
             right = parse_relational_operation();
         }
 
-        if (nullptr == right) {
-            return nullptr;
+        if (null_node == right) {
+            return null_node;
         }
 
-        logical_and->left  = left;
-        logical_and->right = right;
+        nodes_[logical_and].left  = left;
+        nodes_[logical_and].right = right;
         left = logical_and;
     }
 
     return left;
 }
 
-std::shared_ptr<tree::tree_node> expression_tree::parse_parentheses() {
+node_index expression_tree::parse_parentheses() {
     if (tokenizer_.has_tokens() && tokenizer_.weak_next_token().is(token::token_type::lp)) {
         tokenizer_.pass_token();
         auto expression = parse_expression();
@@ -131,31 +161,36 @@ std::shared_ptr<tree::tree_node> expression_tree::parse_parentheses() {
         }
     }
 
-    return nullptr;
+    return null_node;
 }
 
-std::shared_ptr<tree::tree_node> expression_tree::parse_relational_operation() {
+node_index expression_tree::parse_relational_operation() {
     auto left = parse_terminal();
     if (tokenizer_.has_tokens()) {
-        auto operation = std::make_shared<tree::tree_node>(tokenizer_.next_token());
+        auto operation = add_node(tokenizer_.next_token());
         auto right = parse_terminal();
-        operation->left  = left;
-        operation->right = right;
+        if (null_node != right) {
+            literals_.push_back(utils::parse_value(nodes_[right].token.value()));
+            nodes_[right].literal_index = static_cast<uint32_t>(literals_.size() - 1);
+        }
+
+        nodes_[operation].left  = left;
+        nodes_[operation].right = right;
         return operation;
     }
 
-    return nullptr;
+    return null_node;
 }
 
-std::shared_ptr<tree::tree_node> expression_tree::parse_terminal() {
+node_index expression_tree::parse_terminal() {
     if (tokenizer_.has_tokens()) {
         auto token = tokenizer_.next_token();
         if (token.is(token::token_type::field)) {
-            return std::make_shared<tree::tree_node>(token);
+            return add_node(token);
         }
     }
 
-    return nullptr;
+    return null_node;
 }
 
 } // tree
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <utility>
+#include <algorithm>
+#include <booleval/tree/node_profiler.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+namespace {
+
+using text_span = std::pair<std::size_t, std::size_t>;
+
+/**
+ * Finds the part of the expression text the node is built from. Quotes
+ * around the values are included, while parentheses are not.
+ */
+text_span find_span(expression_tree const& tree, tree_node const& node, std::string_view const text) {
+    if (null_node == node.left && null_node == node.right) {
+        auto const value = node.token.value();
+        if (value.data() < text.data() || value.data() + value.size() > text.data() + text.size()) {
+            return { text.size(), 0 };
+        }
+
+        auto begin = static_cast<std::size_t>(value.data() - text.data());
+        auto end   = begin + value.size();
+        if (0 != begin && end < text.size() && '"' == text[begin - 1] && '"' == text[end]) {
+            --begin;
+            ++end;
+        }
+        return { begin, end };
+    }
+
+    text_span span{ text.size(), 0 };
+    for (auto const child : { node.left, node.right }) {
+        if (null_node != child) {
+            auto const [begin, end] = find_span(tree, tree.node(child), text);
+            span.first  = std::min(span.first, begin);
+            span.second = std::max(span.second, end);
+        }
+    }
+    return span;
+}
+
+} // namespace
+
+node_statistics node_profiler::statistics(node_index const index) const noexcept {
+    node_statistics statistics;
+    if (index < size_) {
+        statistics.evaluations          = counters_[index].evaluations.load(std::memory_order_relaxed);
+        statistics.satisfied            = counters_[index].satisfied.load(std::memory_order_relaxed);
+        statistics.timed_evaluations    = counters_[index].timed.load(std::memory_order_relaxed);
+        statistics.accessor_nanoseconds = counters_[index].nanoseconds.load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
+void node_profiler::reset() const noexcept {
+    for (std::size_t i = 0; i < size_; ++i) {
+        counters_[i].evaluations.store(0, std::memory_order_relaxed);
+        counters_[i].satisfied.store(0, std::memory_order_relaxed);
+        counters_[i].timed.store(0, std::memory_order_relaxed);
+        counters_[i].nanoseconds.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::vector<node_statistics> node_profiler::report(expression_tree const& tree, std::string_view const text) const {
+    std::vector<node_statistics> result;
+    if (nullptr == tree.root()) {
+        return result;
+    }
+
+    // Operations are visited in pre-order, so each operation precedes its
+    // operands, and then ordered by their positions, since the operands
+    // might have been reordered
+    std::vector<node_index> pending{ tree.index_of(*tree.root()) };
+    while (!pending.empty()) {
+        auto const index = pending.back();
+        pending.pop_back();
+
+        auto const& node = tree.node(index);
+        if (null_node == node.left || null_node == node.right || index >= size_) {
+            continue;
+        }
+
+        auto const [begin, end] = find_span(tree, node, text);
+
+        auto statistics = this->statistics(index);
+        statistics.begin = begin;
+        statistics.end   = std::max(begin, end);
+        statistics.text  = begin < end ? text.substr(begin, end - begin) : std::string_view{};
+        statistics.type  = node.token.type();
+        result.push_back(statistics);
+
+        pending.push_back(node.right);
+        pending.push_back(node.left);
+    }
+
+    // Operations spanning the same text keep their pre-order
+    std::stable_sort(result.begin(), result.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.begin != rhs.begin ? lhs.begin < rhs.begin : lhs.end > rhs.end;
+    });
+
+    return result;
+}
+
+} // tree
+
+} // booleval
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <booleval/tree/program.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+void program::compile(expression_tree const& tree, bool const profiled) {
+    clear();
+    profiled_ = profiled;
+
+    auto const root = tree.root();
+    if (nullptr == root) {
+        return;
+    }
+
+    compile(tree, *root);
+    if (!profiled_) {
+        thread_jumps();
+    }
+}
+
+void program::clear() noexcept {
+    instructions_.clear();
+    constants_.clear();
+    nodes_.clear();
+    profiled_ = false;
+}
+
+void program::compile(expression_tree const& tree, tree_node const& node) {
+    auto const index = tree.index_of(node);
+
+    if (null_node == node.left || null_node == node.right) {
+        emit({ opcode::load_result, token::token_type::unknown, 0 }, index);
+        return;
+    }
+
+    switch (node.token.type()) {
+    case token::token_type::logical_and:
+    case token::token_type::logical_or: {
+        compile(tree, tree.node(node.left));
+
+        auto const jump = instructions_.size();
+        auto const code = node.token.is(token::token_type::logical_and)
+            ? opcode::jump_if_false
+            : opcode::jump_if_true;
+        emit({ code, token::token_type::unknown, 0 }, index);
+
+        compile(tree, tree.node(node.right));
+        instructions_[jump].operand = static_cast<uint32_t>(instructions_.size() - jump - 1);
+        break;
+    }
+
+    case token::token_type::eq:
+    case token::token_type::neq:
+    case token::token_type::gt:
+    case token::token_type::lt:
+    case token::token_type::geq:
+    case token::token_type::leq: {
+        auto const& key     = tree.node(node.left);
+        auto const& literal = tree.node(node.right);
+
+        emit({ opcode::load_field, token::token_type::unknown, key.field_index }, index);
+
+        constants_.push_back({ literal.token.value(), tree.literal(literal) });
+        auto const constant = static_cast<uint32_t>(constants_.size() - 1);
+        emit({ opcode::compare, node.token.type(), constant }, index);
+        break;
+    }
+
+    default:
+        emit({ opcode::load_result, token::token_type::unknown, 0 }, index);
+        return;
+    }
+
+    if (profiled_) {
+        emit({ opcode::record_result, token::token_type::unknown, index }, index);
+    }
+}
+
+void program::emit(instruction const& instruction, node_index const node) {
+    instructions_.push_back(instruction);
+    if (profiled_) {
+        nodes_.push_back(node);
+    }
+}
+
+void program::thread_jumps() noexcept {
+    auto const is_jump = [](opcode const code) {
+        return opcode::jump_if_false == code || opcode::jump_if_true == code;
+    };
+
+    for (std::size_t i = 0; i < instructions_.size(); ++i) {
+        auto& jump = instructions_[i];
+        if (!is_jump(jump.code)) {
+            continue;
+        }
+
+        // The result does not change between the jumps, so a jump of the same kind is
+        // always taken, while the one of the opposite kind is never taken
+        auto target = i + 1 + jump.operand;
+        while (target < instructions_.size() && is_jump(instructions_[target].code)) {
+            if (instructions_[target].code == jump.code) {
+                target += 1 + instructions_[target].operand;
+            } else {
+                target += 1;
+            }
+        }
+
+        jump.operand = static_cast<uint32_t>(target - i - 1);
+    }
+}
+
+} // tree
+
+} // booleval
\ No newline at end of file
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <booleval/tree/reorder.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+namespace {
+
+/**
+ * Estimated time of a comparison following the call of the field's member
+ * function, which also keeps the cost of untimed operations above zero.
+ */
+constexpr double comparison_nanoseconds{ 1.0 };
+
+struct operand {
+    node_index index{ null_node };
+    double rank{ 0.0 };
+};
+
+bool is_logical(tree_node const& node) noexcept {
+    return node.token.is_one_of(token::token_type::logical_and, token::token_type::logical_or);
+}
+
+/**
+ * Estimates the total time spent evaluating the subtree so far, by adding
+ * up the time spent in the relational operations within it.
+ */
+double total_cost(expression_tree const& tree, node_profiler const& profiler, node_index const index) {
+    auto const& node = tree.node(index);
+    if (null_node == node.left || null_node == node.right) {
+        return 0.0;
+    }
+
+    if (is_logical(node)) {
+        return total_cost(tree, profiler, node.left) + total_cost(tree, profiler, node.right);
+    }
+
+    auto const statistics = profiler.statistics(index);
+    return static_cast<double>(statistics.evaluations) *
+        (statistics.mean_accessor_nanoseconds() + comparison_nanoseconds);
+}
+
+/**
+ * Ranks the operand of the logical operation, so the operands with lower ranks
+ * should be evaluated first. Never evaluated operands, as well as the ones which
+ * never decide the result, are ranked last.
+ */
+double rank(expression_tree const& tree, node_profiler const& profiler, node_index const index, token::token_type const type) {
+    auto const statistics = profiler.statistics(index);
+    auto const decided = token::token_type::logical_and == type
+        ? statistics.evaluations - statistics.satisfied
+        : statistics.satisfied;
+
+    if (0 == decided) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    return total_cost(tree, profiler, index) / static_cast<double>(decided);
+}
+
+bool reorder_chain(expression_tree& tree, node_profiler const& profiler, node_index const top) {
+    auto const type = tree.node(top).token.type();
+
+    // Operations of the chain and their operands, in the order of evaluation
+    std::vector<node_index> chain;
+    std::vector<operand> operands;
+
+    std::vector<node_index> pending{ top };
+    while (!pending.empty()) {
+        auto const index = pending.back();
+        pending.pop_back();
+
+        auto const& node = tree.node(index);
+        if (node.token.is(type)) {
+            chain.push_back(index);
+            pending.push_back(node.right);
+            pending.push_back(node.left);
+        } else {
+            operands.push_back({ index, rank(tree, profiler, index, type) });
+        }
+    }
+
+    auto const current = operands;
+    std::stable_sort(operands.begin(), operands.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.rank < rhs.rank;
+    });
+
+    auto reordered = !std::equal(operands.begin(), operands.end(), current.begin(), [](auto const& lhs, auto const& rhs) {
+        return lhs.index == rhs.index;
+    });
+
+    // Top operation keeps its index, so its parent does not need to be updated
+    auto const size = operands.size();
+    for (std::size_t i = 0; i < chain.size(); ++i) {
+        auto& node = tree.node(chain[i]);
+        node.left  = i + 1 < chain.size() ? chain[i + 1] : operands[0].index;
+        node.right = operands[size - 1 - i].index;
+    }
+
+    for (auto const& operand : operands) {
+        if (is_logical(tree.node(operand.index))) {
+            reordered = reorder_chain(tree, profiler, operand.index) || reordered;
+        }
+    }
+
+    return reordered;
+}
+
+} // namespace
+
+bool reorder_operands(expression_tree& tree, node_profiler const& profiler) {
+    auto const root = tree.root();
+    if (nullptr == root || !is_logical(*root)) {
+        return false;
+    }
+
+    return reorder_chain(tree, profiler, tree.index_of(*root));
+}
+
+} // tree
+
+} // booleval
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <algorithm>
+#include <booleval/utils/char_set.hpp>
+#include <booleval/utils/selection.hpp>
+#include <booleval/utils/instruction_set.hpp>
+#include "utils/target.hpp"
+
+namespace booleval {
+
+namespace utils {
+
+namespace {
+
+constexpr std::ptrdiff_t scalar_probe_size{ 16 };
+
+#if defined(BOOLEVAL_X86_KERNELS)
+
+/**
+ * Every block of characters is compared against each character of the set,
+ * and the first match is found from the resulting bitmask.
+ */
+BOOLEVAL_TARGET_SSE42 char const* find_first_sse42(char const* first,
+                                                   char const* const last,
+                                                   char const* chars,
+                                                   std::size_t const size) noexcept {
+    constexpr std::size_t width{ 16 };
+
+    __m128i needles[char_set::max_vector_size];
+    for (std::size_t i = 0; i < size; ++i) {
+        needles[i] = _mm_set1_epi8(chars[i]);
+    }
+
+    for (; static_cast<std::size_t>(last - first) >= width; first += width) {
+        auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+
+        auto matches = _mm_cmpeq_epi8(block, needles[0]);
+        for (std::size_t i = 1; i < size; ++i) {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[i]));
+        }
+
+        auto const mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+        if (0 != mask) {
+            return first + countr_zero(mask);
+        }
+    }
+
+    return first;
+}
+
+BOOLEVAL_TARGET_AVX2 char const* find_first_avx2(char const* first,
+                                                 char const* const last,
+                                                 char const* chars,
+                                                 std::size_t const size) noexcept {
+    constexpr std::size_t width{ 32 };
+
+    __m256i needles[char_set::max_vector_size];
+    for (std::size_t i = 0; i < size; ++i) {
+        needles[i] = _mm256_set1_epi8(chars[i]);
+    }
+
+    for (; static_cast<std::size_t>(last - first) >= width; first += width) {
+        auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first));
+
+        auto matches = _mm256_cmpeq_epi8(block, needles[0]);
+        for (std::size_t i = 1; i < size; ++i) {
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, needles[i]));
+        }
+
+        auto const mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+        if (0 != mask) {
+            return first + countr_zero(mask);
+        }
+    }
+
+    return first;
+}
+
+#endif
+
+} // namespace
+
+char const* char_set::find_first(char const* first, char const* const last) const noexcept {
+#if defined(BOOLEVAL_X86_KERNELS)
+    // Most tokens are short, so a few characters are probed one by one
+    // before paying for setting up the vector registers
+    auto const probe = first + std::min<std::ptrdiff_t>(last - first, scalar_probe_size);
+    first = find_first_scalar(first, probe);
+    if (probe != first) {
+        return first;
+    }
+
+    if (0 != size_ && size_ <= max_vector_size) {
+        switch (active_instruction_set()) {
+        case instruction_set::avx2:
+            first = find_first_avx2(first, last, chars_.data(), size_);
+            break;
+        case instruction_set::sse42:
+            first = find_first_sse42(first, last, chars_.data(), size_);
+            break;
+        default:
+            break;
+        }
+    }
+#endif
+
+    // Characters not covered by whole blocks are scanned one by one
+    return find_first_scalar(first, last);
+}
+
+char const* char_set::find_first_scalar(char const* first, char const* const last) const noexcept {
+    for (; last != first; ++first) {
+        if (contains(*first)) {
+            return first;
+        }
+    }
+    return last;
+}
+
+} // utils
+
+} // booleval
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <limits>
+#include <algorithm>
+#include <booleval/exceptions.hpp>
+#include <booleval/utils/epoch.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+epoch_domain::epoch_domain(std::size_t const max_readers)
+    : slots_(std::make_unique<reader_slot[]>(max_readers)),
+      count_of_slots_(max_readers)
+{}
+
+epoch_domain::~epoch_domain() {
+    for (auto const& retired : retired_) {
+        retired.deleter(retired.object);
+    }
+}
+
+std::size_t epoch_domain::acquire_slot() {
+    for (std::size_t i = 0; i < count_of_slots_; ++i) {
+        auto expected = false;
+        if (slots_[i].used.compare_exchange_strong(expected, true)) {
+            return i;
+        }
+    }
+
+    throw too_many_readers(count_of_slots_);
+}
+
+void epoch_domain::release_slot(std::size_t const slot) noexcept {
+    slots_[slot].epoch.store(quiescent);
+    slots_[slot].used.store(false);
+}
+
+std::size_t epoch_domain::reclaim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reclaim_locked();
+}
+
+std::size_t epoch_domain::retired() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return retired_.size();
+}
+
+void epoch_domain::retire(void* object, void (*deleter)(void*)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Readers announcing the new epoch have observed the object already unlinked
+    retired_.push_back({ object, deleter, epoch_.fetch_add(1) + 1 });
+    reclaim_locked();
+}
+
+std::size_t epoch_domain::reclaim_locked() {
+    auto oldest = std::numeric_limits<uint64_t>::max();
+    for (std::size_t i = 0; i < count_of_slots_; ++i) {
+        auto const epoch = slots_[i].epoch.load();
+        if (quiescent != epoch) {
+            oldest = std::min(oldest, epoch);
+        }
+    }
+
+    auto const reclaimable = std::stable_partition(std::begin(retired_), std::end(retired_), [oldest](auto const& retired) {
+        return retired.epoch > oldest;
+    });
+
+    for (auto iter = reclaimable; iter != std::end(retired_); ++iter) {
+        iter->deleter(iter->object);
+    }
+    retired_.erase(reclaimable, std::end(retired_));
+
+    return retired_.size();
+}
+
+} // utils
+
+} // booleval
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <atomic>
+#include <booleval/utils/instruction_set.hpp>
+#include "utils/target.hpp"
+
+namespace booleval {
+
+namespace utils {
+
+namespace {
+
+[[nodiscard]] std::atomic<instruction_set>& active_set() noexcept {
+    static std::atomic<instruction_set> set{ supported_instruction_set() };
+    return set;
+}
+
+} // namespace
+
+instruction_set supported_instruction_set() noexcept {
+#if defined(BOOLEVAL_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return instruction_set::avx2;
+    } else if (__builtin_cpu_supports("sse4.2")) {
+        return instruction_set::sse42;
+    }
+#endif
+
+    return instruction_set::scalar;
+}
+
+instruction_set active_instruction_set() noexcept {
+    return active_set().load(std::memory_order_relaxed);
+}
+
+void active_instruction_set(instruction_set const set) noexcept {
+    auto const supported = supported_instruction_set();
+    auto const selected  = static_cast<uint8_t>(set) <= static_cast<uint8_t>(supported) ? set : supported;
+    active_set().store(selected, std::memory_order_relaxed);
+}
+
+} // utils
+
+} // booleval
\ No newline at end of file
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <utility>
+#include <booleval/utils/thread_pool.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+thread_pool::thread_pool(std::size_t const workers) {
+    // Last queue belongs to the thread calling parallel_for
+    for (std::size_t i = 0; i <= workers; ++i) {
+        queues_.push_back(std::make_unique<task_queue>());
+    }
+
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this, i] { work(i); });
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void thread_pool::parallel_for(std::size_t const count, std::function<void(std::size_t)> const& task) {
+    if (0 == count) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> call_lock(call_mutex_);
+
+    // Task is published before any index is queued, so a worker that pops
+    // an index (under the queue's mutex) always sees the current task
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        error_ = nullptr;
+        pending_.store(count, std::memory_order_relaxed);
+    }
+
+    auto const queues = queues_.size();
+    for (std::size_t i = 0; i < queues; ++i) {
+        auto& queue = *queues_[i];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (auto index = count * i / queues; index < count * (i + 1) / queues; ++index) {
+            queue.tasks.push_back(index);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    while (execute(queues - 1)) {}
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return 0 == pending_.load(std::memory_order_acquire); });
+    task_ = nullptr;
+
+    if (nullptr != error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+std::size_t thread_pool::default_workers() noexcept {
+    auto const threads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    return threads > 1 ? threads - 1 : 0;
+}
+
+void thread_pool::work(std::size_t const queue) {
+    std::size_t generation{ 0 };
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation != generation_; });
+            if (stop_) {
+                return;
+            }
+            generation = generation_;
+        }
+
+        while (execute(queue)) {}
+    }
+}
+
+bool thread_pool::execute(std::size_t const queue) {
+    std::size_t index{ 0 };
+    if (!pop(queue, index) && !steal(queue, index)) {
+        return false;
+    }
+
+    try {
+        (*task_)(index);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (nullptr == error_) {
+            error_ = std::current_exception();
+        }
+    }
+
+    if (1 == pending_.fetch_sub(1, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_.notify_all();
+    }
+
+    return true;
+}
+
+bool thread_pool::pop(std::size_t const queue, std::size_t& task) {
+    auto& own = *queues_[queue];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.tasks.empty()) {
+        return false;
+    }
+
+    task = own.tasks.back();
+    own.tasks.pop_back();
+    return true;
+}
+
+bool thread_pool::steal(std::size_t const queue, std::size_t& task) {
+    auto const queues = queues_.size();
+    for (std::size_t i = 1; i < queues; ++i) {
+        auto& victim = *queues_[(queue + i) % queues];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+} // utils
+
+} // booleval
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_TESTS_ALLOCATION_COUNTER_H
+#define BOOLEVAL_TESTS_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+#if defined(BOOLEVAL_COUNT_ALLOCATIONS)
+/**
+ * Number of allocations made by the current thread, incremented by
+ * the replacement global operator new of the allocation test targets.
+ */
+extern thread_local std::size_t thread_allocations;
+#endif
+
+/**
+ * class allocation_counter
+ *
+ * Counts the allocations made by the current thread since the counter was
+ * created. Tests are built both with and without counting the allocations,
+ * and the count is always zero when allocations are not counted.
+ */
+class allocation_counter {
+public:
+    allocation_counter() noexcept
+        : start_(allocations())
+    {}
+
+    /**
+     * Gets the number of allocations made since the counter was created.
+     *
+     * @return Number of allocations
+     */
+    [[nodiscard]] std::size_t count() const noexcept {
+        return allocations() - start_;
+    }
+
+private:
+    [[nodiscard]] static std::size_t allocations() noexcept {
+#if defined(BOOLEVAL_COUNT_ALLOCATIONS)
+        return thread_allocations;
+#else
+        return 0;
+#endif
+    }
+
+private:
+    std::size_t start_;
+};
+
+#endif // BOOLEVAL_TESTS_ALLOCATION_COUNTER_H
\ No newline at end of file
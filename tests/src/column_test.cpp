@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/column.hpp>
+
+class ColumnTest : public testing::Test {};
+
+TEST_F(ColumnTest, DefaultConstructor) {
+    booleval::column column;
+    EXPECT_EQ(column.data(), nullptr);
+    EXPECT_EQ(column.size(), 0U);
+    EXPECT_EQ(column.type(), booleval::column_type::unknown);
+}
+
+TEST_F(ColumnTest, ContiguousValues) {
+    std::vector<int32_t> values{ 1, 2, 3 };
+
+    booleval::column column(values.data(), values.size());
+    EXPECT_EQ(column.data(), values.data());
+    EXPECT_EQ(column.size(), 3U);
+    EXPECT_EQ(column.stride(), sizeof(int32_t));
+    EXPECT_EQ(column.type(), booleval::column_type::int32);
+}
+
+TEST_F(ColumnTest, StridedValues) {
+    struct record {
+        double value;
+        std::string name;
+    };
+
+    std::vector<record> records{ { 1.0, "one" }, { 2.0, "two" } };
+
+    booleval::column values(&records[0].value, records.size(), sizeof(record));
+    EXPECT_EQ(values.stride(), sizeof(record));
+    EXPECT_EQ(values.type(), booleval::column_type::float64);
+
+    booleval::column names(&records[0].name, records.size(), sizeof(record));
+    EXPECT_EQ(names.type(), booleval::column_type::string);
+}
+
+TEST_F(ColumnTest, ColumnTypes) {
+    using namespace booleval;
+
+    EXPECT_EQ(column_type_of<bool>(), column_type::boolean);
+    EXPECT_EQ(column_type_of<int8_t>(), column_type::int8);
+    EXPECT_EQ(column_type_of<int64_t const>(), column_type::int64);
+    EXPECT_EQ(column_type_of<uint16_t>(), column_type::uint16);
+    EXPECT_EQ(column_type_of<float>(), column_type::float32);
+    EXPECT_EQ(column_type_of<std::string_view>(), column_type::string_view);
+    EXPECT_EQ(column_type_of<char const*>(), column_type::unknown);
+}
+
+TEST_F(ColumnTest, Visit) {
+    std::vector<uint64_t> values{ 42 };
+
+    booleval::column column(values.data(), values.size());
+    auto const first = column.visit([](auto const* value) {
+        using T = std::remove_cv_t<std::remove_pointer_t<decltype(value)>>;
+        if constexpr (std::is_same_v<T, uint64_t>) {
+            return *value;
+        } else {
+            return uint64_t{ 0 };
+        }
+    });
+    EXPECT_EQ(first, 42U);
+}
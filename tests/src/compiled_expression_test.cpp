@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/compiled_expression.hpp>
+
+class CompiledExpressionTest : public testing::Test {
+public:
+    class obj {
+    public:
+        obj(std::string value_a, uint32_t value_b) : value_a_{ std::move(value_a) }, value_b_{ value_b } {}
+        std::string const& value_a() const noexcept { return value_a_; }
+        uint32_t value_b() const noexcept { return value_b_; }
+
+    private:
+        std::string value_a_;
+        uint32_t value_b_;
+    };
+
+protected:
+    std::map<std::string_view, booleval::utils::any_mem_fn> const fields_{
+        { "field_a", &obj::value_a },
+        { "field_b", &obj::value_b }
+    };
+};
+
+TEST_F(CompiledExpressionTest, Construction) {
+    using namespace booleval;
+
+    compiled_expression<> const expression("field_a foo and field_b gt 1", fields_);
+    EXPECT_EQ(expression.text(), "field_a foo and field_b gt 1");
+    EXPECT_EQ(expression.mode(), tree::evaluation_mode::short_circuit);
+    EXPECT_EQ(expression.strategy(), tree::evaluation_strategy::tree_walk);
+
+    EXPECT_TRUE(expression.evaluate(obj("foo", 2)));
+    EXPECT_FALSE(expression.evaluate(obj("foo", 1)));
+    EXPECT_FALSE(expression.evaluate(obj("bar", 2)));
+
+    compiled_expression<> const eager("field_a foo", fields_, tree::evaluation_mode::eager, tree::evaluation_strategy::bytecode);
+    EXPECT_EQ(eager.mode(), tree::evaluation_mode::eager);
+    EXPECT_EQ(eager.strategy(), tree::evaluation_strategy::bytecode);
+    EXPECT_TRUE(eager.evaluate(obj("foo", 2)));
+}
+
+TEST_F(CompiledExpressionTest, InvalidExpression) {
+    using namespace booleval;
+
+    EXPECT_THROW(compiled_expression<>("(field_a foo", fields_), invalid_expression);
+    EXPECT_THROW(compiled_expression<>("field_a foo field_b", fields_), invalid_expression);
+    EXPECT_THROW(compiled_expression<>("field_c foo", fields_), field_not_found);
+}
+
+TEST_F(CompiledExpressionTest, OwnsExpressionText) {
+    using namespace booleval;
+
+    std::unique_ptr<compiled_expression<> const> expression;
+    {
+        std::string text("field_a \"foo bar\" or field_b leq 5");
+        expression = std::make_unique<compiled_expression<> const>(text, fields_);
+        text.assign(text.size(), 'x');
+    }
+
+    EXPECT_TRUE(expression->evaluate(obj("foo bar", 10)));
+    EXPECT_TRUE(expression->evaluate(obj("baz", 5)));
+    EXPECT_FALSE(expression->evaluate(obj("baz", 6)));
+}
+
+TEST_F(CompiledExpressionTest, ConcurrentEvaluation) {
+    using namespace booleval;
+
+    std::vector<obj> objects;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        objects.emplace_back(i % 3 == 0 ? "foo" : "bar", i);
+    }
+
+    auto const expression = std::make_shared<compiled_expression<> const>("field_a foo and field_b lt 500", fields_);
+
+    std::vector<std::size_t> matches(4, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < matches.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (auto const& object : objects) {
+                matches[t] += expression->evaluate(object) ? 1 : 0;
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto const count : matches) {
+        EXPECT_EQ(count, 167U);
+    }
+}
+
+TEST_F(CompiledExpressionTest, Reordered) {
+    using namespace booleval;
+
+    std::vector<obj> objects;
+    for (uint32_t i = 0; i < 300; ++i) {
+        objects.emplace_back(i % 3 == 0 ? "foo" : "bar", i);
+    }
+
+    EXPECT_EQ(compiled_expression<>("field_b lt 1000 and field_a foo", fields_).reordered(), nullptr);
+    EXPECT_EQ(compiled_expression<>("field_b lt 1000 and field_a foo", fields_, tree::evaluation_mode::eager,
+                                    tree::evaluation_strategy::tree_walk, true).reordered(), nullptr);
+
+    compiled_expression<> const expression("field_b lt 1000 and field_a foo", fields_,
+                                           tree::evaluation_mode::short_circuit, tree::evaluation_strategy::bytecode, true);
+    EXPECT_EQ(expression.reordered(), nullptr);
+
+    std::vector<bool> expected;
+    for (auto const& object : objects) {
+        expected.push_back(expression.evaluate(object));
+    }
+    EXPECT_EQ(expression.profiled_evaluations(), objects.size());
+
+    // Comparison of field_b never fails, so it is moved after the one of field_a
+    auto const reordered = expression.reordered();
+    ASSERT_NE(reordered, nullptr);
+    EXPECT_EQ(reordered->text(), expression.text());
+    EXPECT_EQ(reordered->strategy(), tree::evaluation_strategy::bytecode);
+    EXPECT_TRUE(reordered->profiling());
+    EXPECT_EQ(reordered->profiled_evaluations(), 0U);
+    EXPECT_EQ(reordered->reordered(), nullptr);
+
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        EXPECT_EQ(reordered->evaluate(objects[i]), expected[i]);
+    }
+
+    utils::bitmap result;
+    reordered->evaluate_batch(objects.data(), objects.size(), result);
+    EXPECT_EQ(result.count(), 100U);
+
+    auto const report = reordered->profile();
+    ASSERT_EQ(report.size(), 3U);
+    EXPECT_EQ(report[1].text, "field_b lt 1000");
+    EXPECT_EQ(report[1].evaluations, 200U);
+    EXPECT_EQ(report[2].text, "field_a foo");
+    EXPECT_EQ(report[2].evaluations, 600U);
+
+    // Order stays the same with the same statistics
+    EXPECT_EQ(reordered->reordered(), nullptr);
+
+    // Operands are already in the best order, so the nested chain is not rebuilt
+    compiled_expression<> const nested("field_a foo and (field_b gt 100 and field_b lt 1000)", fields_,
+                                       tree::evaluation_mode::short_circuit, tree::evaluation_strategy::bytecode, true);
+    for (auto const& object : objects) {
+        static_cast<void>(nested.evaluate(object));
+    }
+    EXPECT_EQ(nested.reordered(), nullptr);
+}
@@ -27,11 +27,27 @@
  *
  */
 
+#include <string>
+#include <vector>
+#include <string_view>
 #include <gtest/gtest.h>
 #include <booleval/evaluator.hpp>
+#include "allocation_counter.hpp"
 
 class EvaluatorTest : public testing::Test {
 public:
+    /**
+     * Evaluates the object and checks that the evaluation does not allocate
+     * (checked only when the test is built with allocations counted).
+     */
+    template <typename Evaluator, typename T>
+    static bool evaluate(Evaluator const& evaluator, T const& obj) {
+        allocation_counter const counter;
+        auto const result = evaluator.evaluate(obj);
+        EXPECT_EQ(counter.count(), 0U);
+        return result;
+    }
+
     template <typename T>
     class obj {
     public:
@@ -68,21 +84,21 @@ TEST_F(EvaluatorTest, EmptyExpression) {
     booleval::evaluator<> evaluator;
     EXPECT_TRUE(evaluator.expression(""));
     EXPECT_FALSE(evaluator.is_activated());
-    EXPECT_FALSE(evaluator.evaluate(obj<uint8_t>()));
+    EXPECT_FALSE(evaluate(evaluator, obj<uint8_t>()));
 }
 
 TEST_F(EvaluatorTest, MissingClosingParenthesesExpression) {
     booleval::evaluator<> evaluator;
     EXPECT_FALSE(evaluator.expression("(field_a foo or field_b bar"));
     EXPECT_FALSE(evaluator.is_activated());
-    EXPECT_FALSE(evaluator.evaluate(obj<uint8_t>()));
+    EXPECT_FALSE(evaluate(evaluator, obj<uint8_t>()));
 }
 
 TEST_F(EvaluatorTest, MultipleFieldsExpression) {
     booleval::evaluator<> evaluator;
     EXPECT_FALSE(evaluator.expression("field_a foo field_b"));
     EXPECT_FALSE(evaluator.is_activated());
-    EXPECT_FALSE(evaluator.evaluate(obj<uint8_t>()));
+    EXPECT_FALSE(evaluate(evaluator, obj<uint8_t>()));
 }
 
 TEST_F(EvaluatorTest, EqualToOperator) {
@@ -95,8 +111,8 @@ TEST_F(EvaluatorTest, EqualToOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a foo"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, SymbolEqualToOperator) {
@@ -109,8 +125,8 @@ TEST_F(EvaluatorTest, SymbolEqualToOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a == foo"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, EqualToOperatorMultipleWords) {
@@ -123,8 +139,8 @@ TEST_F(EvaluatorTest, EqualToOperatorMultipleWords) {
 
     EXPECT_TRUE(evaluator.expression("field_a \"foo foo\""));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, NotEqualToOperator) {
@@ -137,8 +153,8 @@ TEST_F(EvaluatorTest, NotEqualToOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a neq foo"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_FALSE(evaluator.evaluate(foo));
-    EXPECT_TRUE(evaluator.evaluate(bar));
+    EXPECT_FALSE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, SymbolNotEqualToOperator) {
@@ -151,8 +167,8 @@ TEST_F(EvaluatorTest, SymbolNotEqualToOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a != foo"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_FALSE(evaluator.evaluate(foo));
-    EXPECT_TRUE(evaluator.evaluate(bar));
+    EXPECT_FALSE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, GreaterThanOperator) {
@@ -165,8 +181,8 @@ TEST_F(EvaluatorTest, GreaterThanOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a gt 1.23"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, SymbolGreaterThanOperator) {
@@ -179,8 +195,8 @@ TEST_F(EvaluatorTest, SymbolGreaterThanOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a > 1.23"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, GreaterThanOperatorStrings) {
@@ -193,8 +209,8 @@ TEST_F(EvaluatorTest, GreaterThanOperatorStrings) {
 
     EXPECT_TRUE(evaluator.expression("field_a gt \"200\""));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, LessThanOperator) {
@@ -207,8 +223,8 @@ TEST_F(EvaluatorTest, LessThanOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a lt 2"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, SymbolLessThanOperator) {
@@ -221,8 +237,8 @@ TEST_F(EvaluatorTest, SymbolLessThanOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a < 2"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, LessThanOperatorStrings) {
@@ -235,8 +251,8 @@ TEST_F(EvaluatorTest, LessThanOperatorStrings) {
 
     EXPECT_TRUE(evaluator.expression("field_a lt \"200\""));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
 }
 
 TEST_F(EvaluatorTest, GreaterThanOrEqualToOperator) {
@@ -250,9 +266,9 @@ TEST_F(EvaluatorTest, GreaterThanOrEqualToOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a geq 1.234567"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_TRUE(evaluator.evaluate(bar));
-    EXPECT_FALSE(evaluator.evaluate(baz));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
+    EXPECT_FALSE(evaluate(evaluator, baz));
 }
 
 TEST_F(EvaluatorTest, SymbolGreaterThanOrEqualToOperator) {
@@ -266,9 +282,9 @@ TEST_F(EvaluatorTest, SymbolGreaterThanOrEqualToOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a >= 1.234567"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_TRUE(evaluator.evaluate(bar));
-    EXPECT_FALSE(evaluator.evaluate(baz));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
+    EXPECT_FALSE(evaluate(evaluator, baz));
 }
 
 TEST_F(EvaluatorTest, LessThanOrEqualToOperator) {
@@ -282,9 +298,9 @@ TEST_F(EvaluatorTest, LessThanOrEqualToOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a leq 1.234567"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_TRUE(evaluator.evaluate(bar));
-    EXPECT_FALSE(evaluator.evaluate(baz));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
+    EXPECT_FALSE(evaluate(evaluator, baz));
 }
 
 TEST_F(EvaluatorTest, SymbolLessThanOrEqualToOperator) {
@@ -298,9 +314,9 @@ TEST_F(EvaluatorTest, SymbolLessThanOrEqualToOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a <= 1.234567"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_TRUE(evaluator.evaluate(bar));
-    EXPECT_FALSE(evaluator.evaluate(baz));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
+    EXPECT_FALSE(evaluate(evaluator, baz));
 }
 
 TEST_F(EvaluatorTest, AndOperator) {
@@ -315,9 +331,9 @@ TEST_F(EvaluatorTest, AndOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a one and field_b 1"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
-    EXPECT_FALSE(evaluator.evaluate(baz));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
+    EXPECT_FALSE(evaluate(evaluator, baz));
 }
 
 TEST_F(EvaluatorTest, SymbolAndOperator) {
@@ -332,9 +348,9 @@ TEST_F(EvaluatorTest, SymbolAndOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a one && field_b 1"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
-    EXPECT_FALSE(evaluator.evaluate(baz));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
+    EXPECT_FALSE(evaluate(evaluator, baz));
 }
 
 TEST_F(EvaluatorTest, OrOperator) {
@@ -350,10 +366,10 @@ TEST_F(EvaluatorTest, OrOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a one or field_b 1"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_TRUE(evaluator.evaluate(bar));
-    EXPECT_TRUE(evaluator.evaluate(baz));
-    EXPECT_FALSE(evaluator.evaluate(qux));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
+    EXPECT_TRUE(evaluate(evaluator, baz));
+    EXPECT_FALSE(evaluate(evaluator, qux));
 }
 
 TEST_F(EvaluatorTest, SymbolOrOperator) {
@@ -369,10 +385,10 @@ TEST_F(EvaluatorTest, SymbolOrOperator) {
 
     EXPECT_TRUE(evaluator.expression("field_a one || field_b 1"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_TRUE(evaluator.evaluate(bar));
-    EXPECT_TRUE(evaluator.evaluate(baz));
-    EXPECT_FALSE(evaluator.evaluate(qux));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
+    EXPECT_TRUE(evaluate(evaluator, baz));
+    EXPECT_FALSE(evaluate(evaluator, qux));
 }
 
 TEST_F(EvaluatorTest, MultipleOperators) {
@@ -388,10 +404,332 @@ TEST_F(EvaluatorTest, MultipleOperators) {
 
     EXPECT_TRUE(evaluator.expression("(field_a one and field_b 1) or (field_a two and field_b 2)"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
-    EXPECT_FALSE(evaluator.evaluate(baz));
-    EXPECT_TRUE(evaluator.evaluate(qux));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
+    EXPECT_FALSE(evaluate(evaluator, baz));
+    EXPECT_TRUE(evaluate(evaluator, qux));
+}
+
+TEST_F(EvaluatorTest, EvaluationModes) {
+    multi_obj<std::string, uint8_t> foo{ "one", 1 };
+    multi_obj<std::string, uint8_t> bar{ "two", 2 };
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    EXPECT_EQ(evaluator.mode(), booleval::tree::evaluation_mode::short_circuit);
+    EXPECT_TRUE(evaluator.expression("field_a one and field_b 1 or field_b 2"));
+
+    for (auto const mode : { booleval::tree::evaluation_mode::short_circuit,
+                             booleval::tree::evaluation_mode::eager }) {
+        evaluator.mode(mode);
+        EXPECT_EQ(evaluator.mode(), mode);
+        EXPECT_TRUE(evaluate(evaluator, foo));
+        EXPECT_TRUE(evaluate(evaluator, bar));
+    }
+}
+
+TEST_F(EvaluatorTest, EvaluationStrategies) {
+    std::vector<multi_obj<std::string, uint8_t>> objects{
+        { "one", 1 }, { "two", 2 }, { "three", 3 }, { "four", 4 }
+    };
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    EXPECT_EQ(evaluator.strategy(), booleval::tree::evaluation_strategy::tree_walk);
+
+    for (auto const expression : { "field_a one and field_b 1 or field_b 2",
+                                   "field_b gt 1 and (field_a two or field_a four)",
+                                   "(field_b lt 2 or field_b geq 4) and field_a neq one",
+                                   "field_b leq 3 and field_b gt 1 and field_a three or field_a one" }) {
+        EXPECT_TRUE(evaluator.expression(expression));
+
+        for (auto const& object : objects) {
+            evaluator.strategy(booleval::tree::evaluation_strategy::tree_walk);
+            auto const expected = evaluate(evaluator, object);
+
+            evaluator.strategy(booleval::tree::evaluation_strategy::bytecode);
+            EXPECT_EQ(evaluator.strategy(), booleval::tree::evaluation_strategy::bytecode);
+            EXPECT_EQ(evaluate(evaluator, object), expected);
+        }
+    }
+}
+
+TEST_F(EvaluatorTest, BatchEvaluation) {
+    std::vector<multi_obj<std::string, uint8_t>> objects;
+    for (uint8_t i = 0; i < 150; ++i) {
+        objects.emplace_back(i % 2 == 0 ? "even" : "odd", i);
+    }
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    booleval::utils::bitmap result;
+    evaluator.evaluate_batch(objects.data(), objects.size(), result);
+    EXPECT_EQ(result.size(), objects.size());
+    EXPECT_EQ(result.count(), 0U);
+
+    EXPECT_TRUE(evaluator.expression("field_a even and field_b gt 9 or field_b lt 2"));
+
+    for (auto const mode : { booleval::tree::evaluation_mode::short_circuit,
+                             booleval::tree::evaluation_mode::eager }) {
+        evaluator.mode(mode);
+
+        evaluator.evaluate_batch(objects.data(), objects.size(), result);
+        ASSERT_EQ(result.size(), objects.size());
+        for (std::size_t i = 0; i < objects.size(); ++i) {
+            EXPECT_EQ(result.test(i), evaluate(evaluator, objects[i]));
+        }
+        EXPECT_EQ(result.count(), 72U);
+
+        evaluator.evaluate_batch(std::begin(objects), std::end(objects), result);
+        EXPECT_EQ(result.size(), objects.size());
+        EXPECT_EQ(result.count(), 72U);
+    }
+
+    std::vector<multi_obj<std::string, uint8_t> const*> pointers{
+        &objects[0], nullptr, &objects[1], &objects[10]
+    };
+    evaluator.evaluate_batch(pointers.data(), pointers.size(), result);
+    ASSERT_EQ(result.size(), pointers.size());
+    EXPECT_TRUE(result.test(0));
+    EXPECT_FALSE(result.test(1));
+    EXPECT_TRUE(result.test(2));
+    EXPECT_TRUE(result.test(3));
+}
+
+TEST_F(EvaluatorTest, ParallelEvaluation) {
+    std::vector<multi_obj<std::string, uint8_t>> objects;
+    for (std::size_t i = 0; i < 10000; ++i) {
+        objects.emplace_back(i % 2 == 0 ? "even" : "odd", static_cast<uint8_t>(i % 256));
+    }
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    booleval::utils::thread_pool pool(3);
+    booleval::utils::bitmap result;
+    evaluator.evaluate_parallel(objects.data(), objects.size(), result, pool);
+    EXPECT_EQ(result.size(), objects.size());
+    EXPECT_EQ(result.count(), 0U);
+
+    EXPECT_TRUE(evaluator.expression("field_a even and field_b gt 9 or field_b lt 2"));
+
+    booleval::utils::bitmap expected;
+    evaluator.evaluate_batch(objects.data(), objects.size(), expected);
+
+    for (auto const chunk : { 1U, 64U, 100U, 1000U, 16384U }) {
+        evaluator.evaluate_parallel(objects.data(), objects.size(), result, pool, chunk);
+        ASSERT_EQ(result.size(), objects.size());
+        for (std::size_t i = 0; i < result.words(); ++i) {
+            EXPECT_EQ(result.word(i), expected.word(i));
+        }
+    }
+
+    booleval::utils::thread_pool single(0);
+    evaluator.evaluate_parallel(objects.data(), objects.size(), result, single, 128);
+    EXPECT_EQ(result.count(), expected.count());
+}
+
+TEST_F(EvaluatorTest, SharedCompiledExpression) {
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    EXPECT_EQ(evaluator.compiled(), nullptr);
+
+    EXPECT_TRUE(evaluator.expression(std::string("field_a foo and field_b 1")));
+    auto const compiled = evaluator.compiled();
+    ASSERT_NE(compiled, nullptr);
+    EXPECT_EQ(compiled->text(), "field_a foo and field_b 1");
+
+    multi_obj<std::string, uint8_t> const foo{ "foo", 1 };
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_TRUE(compiled->evaluate(foo));
+
+    // Copies share the compiled expression
+    auto const copy = evaluator;
+    EXPECT_EQ(copy.compiled(), compiled);
+
+    // Reconfiguring compiles the expression again, leaving the shared one untouched
+    evaluator.strategy(booleval::tree::evaluation_strategy::bytecode);
+    EXPECT_NE(evaluator.compiled(), compiled);
+    EXPECT_EQ(evaluator.compiled()->strategy(), booleval::tree::evaluation_strategy::bytecode);
+    EXPECT_EQ(compiled->strategy(), booleval::tree::evaluation_strategy::tree_walk);
+    EXPECT_TRUE(evaluate(evaluator, foo));
+
+    EXPECT_FALSE(evaluator.expression("field_a foo and"));
+    EXPECT_EQ(evaluator.compiled(), nullptr);
+    EXPECT_TRUE(compiled->evaluate(foo));
+}
+
+TEST_F(EvaluatorTest, Profiling) {
+    std::vector<multi_obj<std::string, uint8_t>> objects;
+    for (uint8_t i = 0; i < 150; ++i) {
+        objects.emplace_back(i % 2 == 0 ? "even" : "odd", i);
+    }
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    EXPECT_FALSE(evaluator.profiling());
+    EXPECT_TRUE(evaluator.profile().empty());
+
+    evaluator.profiling(true);
+    EXPECT_TRUE(evaluator.profiling());
+    EXPECT_TRUE(evaluator.profile().empty());
+
+    EXPECT_TRUE(evaluator.expression("field_a even and field_b gt 9 or field_b lt 2"));
+    EXPECT_TRUE(evaluator.compiled()->profiling());
+
+    // Program counts the same evaluations as the tree walk
+    evaluator.strategy(booleval::tree::evaluation_strategy::bytecode);
+
+    struct expected_statistics {
+        std::string_view text;
+        uint64_t evaluations;
+        uint64_t satisfied;
+    };
+
+    std::vector<expected_statistics> const expected{
+        { "field_a even and field_b gt 9 or field_b lt 2", 150, 72 },
+        { "field_a even and field_b gt 9",                 150, 70 },
+        { "field_a even",                                  150, 75 },
+        { "field_b gt 9",                                   75, 70 },
+        { "field_b lt 2",                                   80,  2 }
+    };
+
+    auto check = [&expected](auto const& report, uint64_t const times) {
+        ASSERT_EQ(report.size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(report[i].text, expected[i].text);
+            EXPECT_EQ(report[i].evaluations, expected[i].evaluations * times);
+            EXPECT_EQ(report[i].satisfied, expected[i].satisfied * times);
+        }
+    };
+
+    std::size_t matches{ 0 };
+    for (auto const& object : objects) {
+        matches += evaluate(evaluator, object) ? 1 : 0;
+    }
+    EXPECT_EQ(matches, 72U);
+
+    auto report = evaluator.profile();
+    check(report, 1);
+    EXPECT_EQ(report[0].timed_evaluations, 0U);
+    EXPECT_EQ(report[2].timed_evaluations, 3U);
+    EXPECT_EQ(report[3].timed_evaluations, 2U);
+    EXPECT_EQ(report[4].timed_evaluations, 2U);
+    EXPECT_DOUBLE_EQ(report[2].selectivity(), 0.5);
+
+    // Batches count the same evaluations, since they short-circuit the same way
+    booleval::utils::bitmap result;
+    evaluator.evaluate_batch(objects.data(), objects.size(), result);
+    EXPECT_EQ(result.count(), 72U);
+    check(evaluator.profile(), 2);
+
+    evaluator.compiled()->reset_profile();
+    check(evaluator.profile(), 0);
+
+    evaluator.profiling(false);
+    EXPECT_FALSE(evaluator.compiled()->profiling());
+    EXPECT_TRUE(evaluator.profile().empty());
+}
+
+TEST_F(EvaluatorTest, Adapt) {
+    std::vector<multi_obj<std::string, uint8_t>> objects;
+    for (uint8_t i = 0; i < 200; ++i) {
+        objects.emplace_back(i % 4 == 0 ? "foo" : "bar", i);
+    }
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    EXPECT_FALSE(evaluator.adapt(0));
+    EXPECT_TRUE(evaluator.expression("field_b lt 250 and field_b geq 10 and field_a foo"));
+
+    // Nothing is profiled, so there is nothing to adapt to
+    for (auto const& object : objects) {
+        static_cast<void>(evaluate(evaluator, object));
+    }
+    EXPECT_FALSE(evaluator.adapt(0));
+
+    evaluator.profiling(true);
+    auto const initial = evaluator.compiled();
+
+    std::size_t matches{ 0 };
+    for (auto const& object : objects) {
+        matches += evaluate(evaluator, object) ? 1 : 0;
+    }
+    EXPECT_EQ(matches, 47U);
+
+    EXPECT_FALSE(evaluator.adapt(objects.size() + 1));
+    EXPECT_EQ(evaluator.compiled(), initial);
+    EXPECT_TRUE(evaluator.adapt(objects.size()));
+    EXPECT_NE(evaluator.compiled(), initial);
+    EXPECT_TRUE(evaluator.profiling());
+
+    matches = 0;
+    for (auto const& object : objects) {
+        matches += evaluate(evaluator, object) ? 1 : 0;
+    }
+    EXPECT_EQ(matches, 47U);
+
+    // Comparison which never fails is evaluated last
+    auto const report = evaluator.profile();
+    ASSERT_EQ(report.size(), 5U);
+    EXPECT_EQ(report[1].text, "field_b lt 250");
+    EXPECT_EQ(report[1].evaluations, 47U);
+    EXPECT_EQ(report[3].text, "field_b geq 10");
+    EXPECT_EQ(report[3].evaluations, 50U);
+    EXPECT_EQ(report[4].text, "field_a foo");
+    EXPECT_EQ(report[4].evaluations, 200U);
+
+    // Same order starts profiling from scratch
+    EXPECT_FALSE(evaluator.adapt(objects.size()));
+    EXPECT_EQ(evaluator.profile()[0].evaluations, 0U);
+}
+
+TEST_F(EvaluatorTest, ColumnarEvaluation) {
+    std::vector<std::string> field_a{ "one", "two", "three", "four" };
+    std::vector<uint8_t> field_b{ 1, 2, 3, 4 };
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    std::map<std::string_view, booleval::column> columns{
+        { "field_a", booleval::column(field_a.data(), field_a.size()) },
+        { "field_b", booleval::column(field_b.data(), field_b.size()) }
+    };
+
+    booleval::utils::bitmap result;
+    evaluator.evaluate_columns(columns, result);
+    EXPECT_EQ(result.size(), 4U);
+    EXPECT_EQ(result.count(), 0U);
+
+    EXPECT_TRUE(evaluator.expression("field_b gt 1 and (field_a two or field_a four)"));
+    evaluator.evaluate_columns(columns, result);
+    ASSERT_EQ(result.size(), 4U);
+    for (std::size_t i = 0; i < field_a.size(); ++i) {
+        EXPECT_EQ(result.test(i), evaluate(evaluator, multi_obj<std::string, uint8_t>{ field_a[i], field_b[i] }));
+    }
+    EXPECT_EQ(result.count(), 2U);
 }
 
 TEST_F(EvaluatorTest, FieldsFromDifferentClasses) {
@@ -405,8 +743,62 @@ TEST_F(EvaluatorTest, FieldsFromDifferentClasses) {
 
     EXPECT_TRUE(evaluator.expression("field_a one and field_b 2"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_FALSE(evaluator.evaluate(foo));
-    EXPECT_FALSE(evaluator.evaluate(bar));
+    EXPECT_FALSE(evaluate(evaluator, foo));
+    EXPECT_FALSE(evaluate(evaluator, bar));
+}
+
+TEST_F(EvaluatorTest, FieldsFromDifferentClassesOrOperator) {
+    obj<std::string> foo{ "one" };
+    multi_obj<std::string, uint8_t> bar{ "two", 2 };
+    multi_obj<std::string, uint8_t> baz{ "two", 3 };
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &obj<std::string>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    EXPECT_TRUE(evaluator.expression("field_a one or field_b 2"));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+    EXPECT_TRUE(evaluate(evaluator, bar));
+    EXPECT_TRUE(evaluate(evaluator, &bar));
+    EXPECT_FALSE(evaluate(evaluator, baz));
+}
+
+TEST_F(EvaluatorTest, StringViewAndReferenceFields) {
+    class text_obj {
+    public:
+        text_obj(std::string text) : text_{ std::move(text) } {}
+        std::string_view view() const noexcept { return text_; }
+        std::string const& reference() const noexcept { return text_; }
+        double number() const noexcept { return static_cast<double>(text_.size()); }
+
+    private:
+        std::string text_;
+    };
+
+    // Strings are longer than the small string buffer, so copying them would allocate
+    text_obj const foo{ "a rather long text which does not fit the small string buffer" };
+    text_obj const bar{ "another long text which does not fit the small string buffer" };
+
+    booleval::evaluator<> evaluator({
+        { "view",      &text_obj::view      },
+        { "reference", &text_obj::reference },
+        { "number",    &text_obj::number    }
+    });
+
+    for (auto const strategy : { booleval::tree::evaluation_strategy::tree_walk,
+                                 booleval::tree::evaluation_strategy::bytecode }) {
+        evaluator.strategy(strategy);
+
+        EXPECT_TRUE(evaluator.expression("view \"a rather long text which does not fit the small string buffer\""));
+        EXPECT_TRUE(evaluate(evaluator, foo));
+        EXPECT_FALSE(evaluate(evaluator, bar));
+
+        EXPECT_TRUE(evaluator.expression("reference lt \"another long text which does not fit the small string buffer!\" and number leq 60"));
+        EXPECT_FALSE(evaluate(evaluator, foo));
+        EXPECT_TRUE(evaluate(evaluator, bar));
+        EXPECT_TRUE(evaluate(evaluator, &bar));
+    }
 }
 
 TEST_F(EvaluatorTest, NonExistantField) {
@@ -416,14 +808,68 @@ TEST_F(EvaluatorTest, NonExistantField) {
         { "field_a", &obj<std::string>::value_a }
     });
 
-    EXPECT_TRUE(evaluator.expression("field_not_exist one"));
-    EXPECT_TRUE(evaluator.is_activated());
     try {
-        [[maybe_unused]] auto result = evaluator.evaluate(foo);
+        [[maybe_unused]] auto result = evaluator.expression("field_not_exist one");
         FAIL() << "Expected booleval::field_not_found";
     } catch (booleval::field_not_found const& ex) {
         EXPECT_EQ(ex.what(), std::string("Field 'field_not_exist' not found"));
     }
+
+    EXPECT_FALSE(evaluator.is_activated());
+    EXPECT_FALSE(evaluate(evaluator, foo));
+}
+
+TEST_F(EvaluatorTest, FieldsChangedAfterExpression) {
+    multi_obj<std::string, uint8_t> foo{ "one", 1 };
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+
+    EXPECT_TRUE(evaluator.expression("field_b 1"));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+
+    evaluator.fields({
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+    EXPECT_TRUE(evaluator.is_activated());
+    EXPECT_TRUE(evaluate(evaluator, foo));
+
+    evaluator.strategy(booleval::tree::evaluation_strategy::bytecode);
+    EXPECT_TRUE(evaluate(evaluator, foo));
+
+    EXPECT_THROW(evaluator.fields({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a }
+    }), booleval::field_not_found);
+    EXPECT_FALSE(evaluator.is_activated());
+}
+
+TEST_F(EvaluatorTest, FieldsChangedOnCopy) {
+    multi_obj<std::string, uint8_t> foo{ "one", 1 };
+
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+    EXPECT_TRUE(evaluator.expression("field_b 1"));
+
+    // Copy links the expression to its own fields, without affecting the original
+    auto copy = evaluator;
+    copy.fields({
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b }
+    });
+    EXPECT_TRUE(evaluate(copy, foo));
+    EXPECT_TRUE(evaluate(evaluator, foo));
+
+    copy = evaluator;
+    copy.fields({
+        { "field_b", &multi_obj<std::string, uint8_t>::value_b },
+        { "field_c", &multi_obj<std::string, uint8_t>::value_a },
+        { "field_d", &multi_obj<std::string, uint8_t>::value_a }
+    });
+    EXPECT_TRUE(evaluate(copy, foo));
+    EXPECT_TRUE(evaluate(evaluator, foo));
 }
 
 TEST_F(EvaluatorTest, FieldNotValid) {
@@ -436,9 +882,9 @@ TEST_F(EvaluatorTest, FieldNotValid) {
 
     EXPECT_TRUE(evaluator.expression("field_a_valid foo"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluate(evaluator, foo));
 
     EXPECT_TRUE(evaluator.expression("field_a_not_valid foo"));
     EXPECT_TRUE(evaluator.is_activated());
-    EXPECT_FALSE(evaluator.evaluate(foo));
+    EXPECT_FALSE(evaluate(evaluator, foo));
 }
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/expression_cache.hpp>
+
+class ExpressionCacheTest : public testing::Test {
+public:
+    class obj {
+    public:
+        obj(std::string value_a, uint32_t value_b) : value_a_{ std::move(value_a) }, value_b_{ value_b } {}
+        std::string const& value_a() const noexcept { return value_a_; }
+        uint32_t value_b() const noexcept { return value_b_; }
+
+    private:
+        std::string value_a_;
+        uint32_t value_b_;
+    };
+
+protected:
+    std::map<std::string_view, booleval::utils::any_mem_fn> const fields_{
+        { "field_a", &obj::value_a },
+        { "field_b", &obj::value_b }
+    };
+};
+
+TEST_F(ExpressionCacheTest, HitsAndMisses) {
+    using namespace booleval;
+
+    expression_cache<> cache(fields_);
+
+    auto const first = cache.get("field_a foo and field_b gt 1");
+    ASSERT_NE(first, nullptr);
+    EXPECT_TRUE(first->evaluate(obj("foo", 2)));
+
+    auto const same = cache.get("field_a   == \"foo\" && field_b > 1 ");
+    EXPECT_EQ(same, first);
+
+    auto const other = cache.get("field_a foo or field_b gt 1");
+    EXPECT_NE(other, first);
+
+    auto const statistics = cache.statistics();
+    EXPECT_EQ(statistics.hits, 1U);
+    EXPECT_EQ(statistics.misses, 2U);
+    EXPECT_EQ(statistics.evictions, 0U);
+    EXPECT_EQ(statistics.size, 2U);
+    EXPECT_EQ(statistics.capacity, expression_cache<>::default_capacity);
+}
+
+TEST_F(ExpressionCacheTest, InvalidExpressions) {
+    using namespace booleval;
+
+    expression_cache<> cache(fields_);
+    EXPECT_EQ(cache.get(""), nullptr);
+    EXPECT_EQ(cache.get("   "), nullptr);
+    EXPECT_EQ(cache.get("(field_a foo"), nullptr);
+    EXPECT_THROW(static_cast<void>(cache.get("field_c foo")), field_not_found);
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST_F(ExpressionCacheTest, LeastRecentlyUsedEviction) {
+    using namespace booleval;
+
+    expression_cache<> cache(fields_, 2);
+
+    auto const one = cache.get("field_b 1");
+    auto const two = cache.get("field_b 2");
+    EXPECT_EQ(cache.get("field_b 1"), one);
+
+    // Expression 2 is the least recently used one
+    auto const three = cache.get("field_b 3");
+    EXPECT_EQ(cache.size(), 2U);
+    EXPECT_EQ(cache.statistics().evictions, 1U);
+
+    EXPECT_EQ(cache.get("field_b 1"), one);
+    EXPECT_NE(cache.get("field_b 2"), two);
+
+    // Evicted expression stays usable by its holders
+    EXPECT_TRUE(two->evaluate(obj("foo", 2)));
+
+    auto const statistics = cache.statistics();
+    EXPECT_EQ(statistics.hits, 2U);
+    EXPECT_EQ(statistics.misses, 4U);
+    EXPECT_EQ(statistics.evictions, 2U);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_EQ(cache.statistics().hits, 2U);
+}
+
+TEST_F(ExpressionCacheTest, ZeroCapacity) {
+    using namespace booleval;
+
+    expression_cache<> cache(fields_, 0);
+    auto const first = cache.get("field_b 1");
+    ASSERT_NE(first, nullptr);
+    EXPECT_NE(cache.get("field_b 1"), first);
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_EQ(cache.statistics().misses, 2U);
+}
+
+TEST_F(ExpressionCacheTest, ConcurrentAccess) {
+    using namespace booleval;
+
+    expression_cache<> cache(fields_, 8);
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (uint32_t i = 0; i < 200; ++i) {
+                auto const value = (i + t) % 16;
+                auto const compiled = cache.get("field_b " + std::to_string(value));
+                ASSERT_NE(compiled, nullptr);
+                EXPECT_TRUE(compiled->evaluate(obj("foo", value)));
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto const statistics = cache.statistics();
+    EXPECT_EQ(statistics.hits + statistics.misses, 800U);
+    EXPECT_LE(statistics.size, 8U);
+}
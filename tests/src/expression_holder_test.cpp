@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/expression_holder.hpp>
+
+class ExpressionHolderTest : public testing::Test {
+public:
+    class obj {
+    public:
+        obj(uint32_t value) : value_{ value } {}
+        uint32_t value() const noexcept { return value_; }
+
+    private:
+        uint32_t value_;
+    };
+
+protected:
+    std::map<std::string_view, booleval::utils::any_mem_fn> const fields_{
+        { "field", &obj::value }
+    };
+};
+
+TEST_F(ExpressionHolderTest, Publish) {
+    using namespace booleval;
+
+    expression_holder<> holder(fields_);
+    EXPECT_FALSE(holder.is_activated());
+
+    auto reader = holder.make_reader();
+    EXPECT_FALSE(reader.evaluate(obj(1)));
+
+    EXPECT_TRUE(holder.publish(std::string("field lt 10")));
+    EXPECT_TRUE(holder.is_activated());
+    EXPECT_TRUE(reader.evaluate(obj(1)));
+    EXPECT_FALSE(reader.evaluate(obj(10)));
+
+    // Invalid expression keeps the active one
+    EXPECT_FALSE(holder.publish("(field lt 1"));
+    EXPECT_TRUE(reader.evaluate(obj(1)));
+
+    EXPECT_THROW(static_cast<void>(holder.publish("other 1")), field_not_found);
+    EXPECT_TRUE(reader.evaluate(obj(1)));
+
+    EXPECT_TRUE(holder.publish(""));
+    EXPECT_FALSE(holder.is_activated());
+    EXPECT_FALSE(reader.evaluate(obj(1)));
+}
+
+TEST_F(ExpressionHolderTest, PinnedExpressionOutlivesPublication) {
+    using namespace booleval;
+
+    expression_holder<> holder(fields_);
+    auto reader = holder.make_reader();
+    ASSERT_TRUE(holder.publish("field gt 5"));
+
+    {
+        auto const pinned = reader.pin();
+        ASSERT_TRUE(pinned);
+        EXPECT_EQ(pinned->text(), "field gt 5");
+
+        ASSERT_TRUE(holder.publish("field lt 5"));
+        EXPECT_EQ(holder.reclaim(), 1U);
+
+        // Nested critical section sees the new expression, while the pinned one is still alive
+        EXPECT_TRUE(reader.evaluate(obj(1)));
+        EXPECT_EQ(pinned->text(), "field gt 5");
+        EXPECT_TRUE(pinned->evaluate(obj(6)));
+        EXPECT_EQ(holder.reclaim(), 1U);
+    }
+
+    EXPECT_EQ(holder.reclaim(), 0U);
+}
+
+TEST_F(ExpressionHolderTest, BatchEvaluation) {
+    using namespace booleval;
+
+    std::vector<obj> objects;
+    for (uint32_t i = 0; i < 100; ++i) {
+        objects.emplace_back(i);
+    }
+
+    expression_holder<> holder(fields_);
+    auto reader = holder.make_reader();
+
+    utils::bitmap result;
+    reader.evaluate_batch(objects.data(), objects.size(), result);
+    EXPECT_EQ(result.size(), objects.size());
+    EXPECT_EQ(result.count(), 0U);
+
+    ASSERT_TRUE(holder.publish("field geq 90"));
+    reader.evaluate_batch(objects.data(), objects.size(), result);
+    EXPECT_EQ(result.count(), 10U);
+}
+
+TEST_F(ExpressionHolderTest, ReaderLimit) {
+    using namespace booleval;
+
+    expression_holder<> holder(fields_, tree::evaluation_mode::short_circuit, tree::evaluation_strategy::tree_walk, 1);
+    {
+        auto reader = holder.make_reader();
+        EXPECT_THROW(static_cast<void>(holder.make_reader()), too_many_readers);
+
+        auto moved = std::move(reader);
+        EXPECT_THROW(static_cast<void>(holder.make_reader()), too_many_readers);
+    }
+    auto reader = holder.make_reader();
+    EXPECT_FALSE(reader.evaluate(obj(1)));
+}
+
+TEST_F(ExpressionHolderTest, ConcurrentPublication) {
+    using namespace booleval;
+
+    expression_holder<> holder(fields_);
+    ASSERT_TRUE(holder.publish("field lt 1000"));
+
+    std::atomic<bool> stop{ false };
+    std::atomic<std::size_t> mismatches{ 0 };
+
+    std::vector<std::thread> readers;
+    for (std::size_t t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            auto reader = holder.make_reader();
+            while (!stop.load()) {
+                // Every published expression accepts 0 and rejects 1000
+                if (!reader.evaluate(obj(0)) || reader.evaluate(obj(1000))) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+
+    for (uint32_t i = 1; i <= 500; ++i) {
+        ASSERT_TRUE(holder.publish("field lt " + std::to_string(i)));
+    }
+
+    stop.store(true);
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    EXPECT_EQ(mismatches.load(), 0U);
+    EXPECT_EQ(holder.reclaim(), 0U);
+}
+
+TEST_F(ExpressionHolderTest, Adapt) {
+    using namespace booleval;
+
+    std::vector<obj> objects;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        objects.emplace_back(i);
+    }
+
+    expression_holder<> fixed(fields_);
+    ASSERT_TRUE(fixed.publish("field lt 1000 and field geq 900"));
+    auto fixed_reader = fixed.make_reader();
+    utils::bitmap result;
+    fixed_reader.evaluate_batch(objects.data(), objects.size(), result);
+    EXPECT_FALSE(fixed.adapt(0));
+
+    expression_holder<> holder(fields_, tree::evaluation_mode::short_circuit, tree::evaluation_strategy::tree_walk,
+                               utils::epoch_domain::default_readers, true);
+    EXPECT_FALSE(holder.adapt(0));
+    ASSERT_TRUE(holder.publish("field lt 1000 and field geq 900"));
+
+    auto reader = holder.make_reader();
+    EXPECT_FALSE(holder.adapt(0));
+
+    reader.evaluate_batch(objects.data(), objects.size(), result);
+    EXPECT_EQ(result.count(), 100U);
+    EXPECT_FALSE(holder.adapt(objects.size() + 1));
+
+    {
+        auto const pinned = reader.pin();
+        EXPECT_EQ(pinned->profiled_evaluations(), objects.size());
+
+        EXPECT_TRUE(holder.adapt(objects.size()));
+        EXPECT_EQ(holder.reclaim(), 1U);
+
+        auto const adapted = reader.pin();
+        EXPECT_NE(adapted.get(), pinned.get());
+        EXPECT_EQ(adapted->text(), pinned->text());
+        EXPECT_EQ(adapted->profiled_evaluations(), 0U);
+    }
+    EXPECT_EQ(holder.reclaim(), 0U);
+
+    reader.evaluate_batch(objects.data(), objects.size(), result);
+    EXPECT_EQ(result.count(), 100U);
+
+    auto const report = reader.pin()->profile();
+    ASSERT_EQ(report.size(), 3U);
+    EXPECT_EQ(report[1].text, "field lt 1000");
+    EXPECT_EQ(report[1].evaluations, 100U);
+
+    // Active expression is read through a reader of its own
+    expression_holder<> single(fields_, tree::evaluation_mode::short_circuit, tree::evaluation_strategy::tree_walk, 1, true);
+    ASSERT_TRUE(single.publish("field lt 1000 and field geq 900"));
+    {
+        auto const occupied = single.make_reader();
+        EXPECT_THROW(static_cast<void>(single.adapt(0)), too_many_readers);
+    }
+    EXPECT_FALSE(single.adapt(0));
+}
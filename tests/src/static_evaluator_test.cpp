@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <gtest/gtest.h>
+#include <booleval/static_evaluator.hpp>
+
+namespace {
+
+struct record {
+    std::string field_a_;
+    uint8_t field_b_;
+    double field_c_;
+
+    std::string const& field_a() const noexcept { return field_a_; }
+    uint8_t field_b() noexcept { return field_b_; }
+};
+
+constexpr auto record_fields = booleval::make_fields(
+    booleval::field{ "field_a", &record::field_a },
+    booleval::field{ "field_b", &record::field_b },
+    booleval::field{ "field_c", &record::field_c_ }
+);
+
+using record_evaluator = booleval::static_evaluator<record, record_fields>;
+
+} // namespace
+
+class StaticEvaluatorTest : public testing::Test {};
+
+TEST_F(StaticEvaluatorTest, DefaultConstructor) {
+    record_evaluator evaluator;
+    EXPECT_FALSE(evaluator.is_activated());
+    EXPECT_FALSE(evaluator.evaluate(record{ "foo", 1, 1.5 }));
+}
+
+TEST_F(StaticEvaluatorTest, InvalidExpression) {
+    record_evaluator evaluator;
+    EXPECT_FALSE(evaluator.expression("(field_a foo or field_b 1"));
+    EXPECT_FALSE(evaluator.is_activated());
+}
+
+TEST_F(StaticEvaluatorTest, RelationalOperators) {
+    record foo{ "foo", 1, 1.5 };
+    record bar{ "bar", 2, 2.5 };
+
+    record_evaluator evaluator;
+
+    EXPECT_TRUE(evaluator.expression("field_a foo"));
+    EXPECT_TRUE(evaluator.is_activated());
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_FALSE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a neq foo"));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_b > 1"));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_b lt 2"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_FALSE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_c geq 2.5"));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_c <= 1.5"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_FALSE(evaluator.evaluate(bar));
+}
+
+TEST_F(StaticEvaluatorTest, LogicalOperators) {
+    record foo{ "foo", 1, 1.5 };
+    record bar{ "bar", 2, 2.5 };
+    record baz{ "baz", 1, 2.5 };
+
+    record_evaluator evaluator;
+
+    EXPECT_TRUE(evaluator.expression("(field_a foo and field_b 1) or field_c 2.5 and field_a bar"));
+
+    for (auto const mode : { booleval::tree::evaluation_mode::short_circuit,
+                             booleval::tree::evaluation_mode::eager }) {
+        evaluator.mode(mode);
+        EXPECT_EQ(evaluator.mode(), mode);
+        EXPECT_TRUE(evaluator.evaluate(foo));
+        EXPECT_TRUE(evaluator.evaluate(bar));
+        EXPECT_FALSE(evaluator.evaluate(baz));
+    }
+}
+
+TEST_F(StaticEvaluatorTest, NonExistantField) {
+    record_evaluator evaluator;
+
+    try {
+        [[maybe_unused]] auto result = evaluator.expression("field_not_exist one");
+        FAIL() << "Expected booleval::field_not_found";
+    } catch (booleval::field_not_found const& ex) {
+        EXPECT_EQ(ex.what(), std::string("Field 'field_not_exist' not found"));
+    }
+
+    EXPECT_FALSE(evaluator.is_activated());
+}
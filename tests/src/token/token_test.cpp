@@ -27,6 +27,9 @@
  *
  */
 
+#include <string>
+#include <cctype>
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <booleval/token/token.hpp>
 
@@ -145,4 +148,37 @@ TEST_F(TokenTest, IsOneOfMoreThanTwoTypes) {
     token::token token(token::token_type::logical_and);
     EXPECT_TRUE(token.is_one_of(token::token_type::logical_and, token::token_type::lp, token::token_type::rp));
     EXPECT_FALSE(token.is_one_of(token::token_type::logical_or, token::token_type::lp, token::token_type::rp));
-}
\ No newline at end of file
+}
+
+TEST_F(TokenTest, MapToTokenType) {
+    using namespace booleval;
+
+    for (auto const& [expression, type] : token::keyword_expressions) {
+        std::string upper(expression);
+        std::transform(std::begin(upper), std::end(upper), std::begin(upper), ::toupper);
+        std::string mixed(upper);
+        mixed.front() = static_cast<char>(::tolower(mixed.front()));
+
+        EXPECT_EQ(token::map_to_token_type(expression), type);
+        EXPECT_EQ(token::map_to_token_type(upper), type);
+        EXPECT_EQ(token::map_to_token_type(mixed), type);
+        EXPECT_EQ(token::map_to_token_value(type), expression);
+    }
+
+    for (auto const& [expression, type] : token::symbol_expressions) {
+        EXPECT_EQ(token::map_to_token_type(expression), type);
+    }
+
+    static_assert(token::map_to_token_type("GeQ") == token::token_type::geq);
+    static_assert(token::map_to_token_type("<=") == token::token_type::leq);
+
+    EXPECT_EQ(token::map_to_token_type(""), token::token_type::field);
+    EXPECT_EQ(token::map_to_token_type("a"), token::token_type::field);
+    EXPECT_EQ(token::map_to_token_type("an"), token::token_type::field);
+    EXPECT_EQ(token::map_to_token_type("ad"), token::token_type::field);
+    EXPECT_EQ(token::map_to_token_type("andd"), token::token_type::field);
+    EXPECT_EQ(token::map_to_token_type("ned"), token::token_type::field);
+    EXPECT_EQ(token::map_to_token_type("=!"), token::token_type::field);
+    EXPECT_EQ(token::map_to_token_type("&"), token::token_type::field);
+    EXPECT_EQ(token::map_to_token_type("field_a"), token::token_type::field);
+}
@@ -27,6 +27,9 @@
  *
  */
 
+#include <array>
+#include <vector>
+#include <algorithm>
 #include <string_view>
 #include <gtest/gtest.h>
 #include <booleval/token/tokenizer.hpp>
@@ -219,3 +222,52 @@ TEST_F(TokenizerTest, Reset) {
     EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
     EXPECT_EQ(tokenizer.next_token().value(), "foo");
 }
+
+TEST_F(TokenizerTest, CanonicalForm) {
+    using namespace booleval;
+
+    auto const canonical = [](std::string_view const expression) {
+        token::tokenizer tokenizer(expression);
+        tokenizer.tokenize();
+        return tokenizer.canonical_form();
+    };
+
+    auto const expected = canonical("(field_a foo and field_b gt 1) or field_c != 2");
+    EXPECT_EQ(canonical("( field_a   foo AND field_b > 1 ) || field_c neq 2"), expected);
+    EXPECT_EQ(canonical("(\"field_a\" eq \"foo\" && field_b gt 1) or field_c != 2"), expected);
+    EXPECT_EQ(canonical("(field_a == foo and field_b gt 1) or field_c != 2"), expected);
+
+    EXPECT_NE(canonical("field_a \"foo bar\""), canonical("field_a foo bar"));
+    EXPECT_NE(canonical("field_a \"and\""), canonical("field_a and"));
+    EXPECT_NE(canonical("field_a foo"), canonical("field_a fo"));
+    EXPECT_EQ(canonical(""), "");
+}
+
+TEST_F(TokenizerTest, TokenizeIntoStorage) {
+    using namespace booleval;
+
+    static_assert(token::parenthesis_delimiters() == "()");
+
+    std::string_view expression{ "(field_a foo and field_b \"bar baz\") or field_c gt 2" };
+
+    token::tokenizer tokenizer(expression);
+    tokenizer.tokenize();
+
+    std::vector<token::token> expected;
+    while (tokenizer.has_tokens()) {
+        expected.push_back(tokenizer.next_token());
+    }
+
+    std::array<token::token, 16> storage;
+    auto const count = token::tokenizer::tokenize(expression, storage.data(), storage.size());
+    ASSERT_EQ(count, expected.size());
+    EXPECT_TRUE(std::equal(std::begin(expected), std::end(expected), std::begin(storage)));
+
+    // Storage too small for the expression is only filled up to its capacity
+    std::array<token::token, 4> small;
+    EXPECT_EQ(token::tokenizer::tokenize(expression, small.data(), small.size()), expected.size());
+    EXPECT_TRUE(std::equal(std::begin(small), std::end(small), std::begin(expected)));
+
+    EXPECT_EQ(token::tokenizer::tokenize("", nullptr, 0), 0U);
+    EXPECT_EQ(token::tokenizer::tokenize(expression, nullptr, 0), expected.size());
+}
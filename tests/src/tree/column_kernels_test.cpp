@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/tree/column_kernels.hpp>
+#include <booleval/utils/instruction_set.hpp>
+
+class ColumnKernelsTest : public testing::Test {
+public:
+    void TearDown() override {
+        booleval::utils::active_instruction_set(booleval::utils::supported_instruction_set());
+    }
+
+protected:
+    template <typename T>
+    static std::vector<T> make_values(std::size_t const count) {
+        using limits = std::numeric_limits<T>;
+
+        std::vector<T> values(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            switch (i % 7) {
+            case 0:  values[i] = limits::lowest(); break;
+            case 1:  values[i] = limits::max();    break;
+            case 2:  values[i] = T{ 0 };           break;
+            case 3:  values[i] = T{ 1 };           break;
+            default: values[i] = static_cast<T>(i % 5); break;
+            }
+        }
+        if constexpr (std::is_floating_point_v<T>) {
+            for (std::size_t i = 5; i < count; i += 11) {
+                values[i] = limits::quiet_NaN();
+            }
+        }
+        return values;
+    }
+
+    template <typename T>
+    static void expect_same_as_scalar(T const literal) {
+        using namespace booleval;
+
+        std::vector<token::token_type> const relations{
+            token::token_type::eq,
+            token::token_type::neq,
+            token::token_type::gt,
+            token::token_type::lt,
+            token::token_type::geq,
+            token::token_type::leq
+        };
+
+        std::vector<utils::instruction_set> const sets{
+            utils::instruction_set::sse42,
+            utils::instruction_set::avx2
+        };
+
+        for (auto const count : { 0U, 1U, 7U, 63U, 64U, 65U, 130U, 257U }) {
+            auto const values = make_values<T>(count);
+            auto const words  = (count + 63) / 64;
+
+            for (auto const relation : relations) {
+                utils::active_instruction_set(utils::instruction_set::scalar);
+                std::vector<uint64_t> expected(words);
+                tree::compare_contiguous(values.data(), count, literal, relation, expected.data());
+
+                for (auto const set : sets) {
+                    utils::active_instruction_set(set);
+                    std::vector<uint64_t> actual(words);
+                    tree::compare_contiguous(values.data(), count, literal, relation, actual.data());
+                    EXPECT_EQ(actual, expected);
+                }
+            }
+        }
+    }
+};
+
+TEST_F(ColumnKernelsTest, CompareScalar) {
+    using namespace booleval;
+
+    utils::active_instruction_set(utils::instruction_set::scalar);
+
+    std::vector<int32_t> const values{ 1, 2, 3, 4, 5 };
+    uint64_t result{ 0 };
+
+    tree::compare_contiguous(values.data(), values.size(), 3, token::token_type::eq, &result);
+    EXPECT_EQ(result, 0b00100U);
+
+    tree::compare_contiguous(values.data(), values.size(), 3, token::token_type::neq, &result);
+    EXPECT_EQ(result, 0b11011U);
+
+    tree::compare_contiguous(values.data(), values.size(), 3, token::token_type::gt, &result);
+    EXPECT_EQ(result, 0b11000U);
+
+    tree::compare_contiguous(values.data(), values.size(), 3, token::token_type::lt, &result);
+    EXPECT_EQ(result, 0b00011U);
+
+    tree::compare_contiguous(values.data(), values.size(), 3, token::token_type::geq, &result);
+    EXPECT_EQ(result, 0b11100U);
+
+    tree::compare_contiguous(values.data(), values.size(), 3, token::token_type::leq, &result);
+    EXPECT_EQ(result, 0b00111U);
+
+    tree::compare_contiguous(values.data(), values.size(), 3, token::token_type::logical_and, &result);
+    EXPECT_EQ(result, 0U);
+}
+
+TEST_F(ColumnKernelsTest, CompareNaN) {
+    using namespace booleval;
+
+    std::vector<double> const values{ 1.0, std::nan(""), 3.0 };
+    uint64_t result{ 0 };
+
+    tree::compare_contiguous(values.data(), values.size(), 1.0, token::token_type::neq, &result);
+    EXPECT_EQ(result, 0b110U);
+
+    tree::compare_contiguous(values.data(), values.size(), 1.0, token::token_type::geq, &result);
+    EXPECT_EQ(result, 0b101U);
+}
+
+TEST_F(ColumnKernelsTest, CompareSignedIntegers) {
+    expect_same_as_scalar<int32_t>(1);
+    expect_same_as_scalar<int32_t>(std::numeric_limits<int32_t>::lowest());
+    expect_same_as_scalar<int64_t>(-1);
+    expect_same_as_scalar<int64_t>(std::numeric_limits<int64_t>::max());
+}
+
+TEST_F(ColumnKernelsTest, CompareUnsignedIntegers) {
+    expect_same_as_scalar<uint32_t>(1U);
+    expect_same_as_scalar<uint32_t>(std::numeric_limits<uint32_t>::max());
+    expect_same_as_scalar<uint64_t>(0U);
+    expect_same_as_scalar<uint64_t>(std::numeric_limits<uint64_t>::max() - 1);
+}
+
+TEST_F(ColumnKernelsTest, CompareFloatingPoint) {
+    expect_same_as_scalar<float>(1.0F);
+    expect_same_as_scalar<float>(std::numeric_limits<float>::lowest());
+    expect_same_as_scalar<double>(2.0);
+    expect_same_as_scalar<double>(std::numeric_limits<double>::max());
+}
+
+TEST_F(ColumnKernelsTest, CombineWords) {
+    using namespace booleval::tree;
+    using booleval::utils::instruction_set;
+
+    for (auto const set : { instruction_set::scalar, instruction_set::sse42, instruction_set::avx2 }) {
+        booleval::utils::active_instruction_set(set);
+
+        std::vector<uint64_t> const other{ 0b1100, 0b1010, 0, ~uint64_t{ 0 }, 0b1, 0b11, 0b111 };
+
+        std::vector<uint64_t> conjunction{ 0b1010, 0b1010, 0b1, 0b1, ~uint64_t{ 0 }, 0b10, 0 };
+        and_words(conjunction.data(), other.data(), other.size());
+        EXPECT_EQ(conjunction, (std::vector<uint64_t>{ 0b1000, 0b1010, 0, 0b1, 0b1, 0b10, 0 }));
+
+        std::vector<uint64_t> disjunction{ 0b1010, 0b1010, 0b1, 0b1, 0, 0b100, 0 };
+        or_words(disjunction.data(), other.data(), other.size());
+        EXPECT_EQ(disjunction, (std::vector<uint64_t>{ 0b1110, 0b1010, 0b1, ~uint64_t{ 0 }, 0b1, 0b111, 0b111 }));
+    }
+}
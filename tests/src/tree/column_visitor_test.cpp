@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/column.hpp>
+#include <booleval/exceptions.hpp>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/tree/column_visitor.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+class ColumnVisitorTest : public testing::Test {
+public:
+    booleval::utils::bitmap evaluate(std::string_view const expression,
+                                     booleval::tree::column_visitor::column_map const& columns) {
+        booleval::tree::expression_tree tree;
+        EXPECT_TRUE(tree.build(expression));
+
+        booleval::utils::bitmap result;
+        visitor_.visit(tree, columns, result);
+        return result;
+    }
+
+    std::string to_string(booleval::utils::bitmap const& bits) {
+        std::string result;
+        for (std::size_t i = 0; i < bits.size(); ++i) {
+            result += bits.test(i) ? '1' : '0';
+        }
+        return result;
+    }
+
+protected:
+    booleval::tree::column_visitor visitor_;
+};
+
+TEST_F(ColumnVisitorTest, RelationalOperations) {
+    std::vector<int32_t> values{ -2, -1, 0, 1, 2 };
+    booleval::tree::column_visitor::column_map columns{
+        { "field_a", booleval::column(values.data(), values.size()) }
+    };
+
+    EXPECT_EQ(to_string(evaluate("field_a 0", columns)), "00100");
+    EXPECT_EQ(to_string(evaluate("field_a neq 0", columns)), "11011");
+    EXPECT_EQ(to_string(evaluate("field_a gt 0", columns)), "00011");
+    EXPECT_EQ(to_string(evaluate("field_a lt 0", columns)), "11000");
+    EXPECT_EQ(to_string(evaluate("field_a geq 0", columns)), "00111");
+    EXPECT_EQ(to_string(evaluate("field_a leq 0", columns)), "11100");
+}
+
+TEST_F(ColumnVisitorTest, LiteralsNotRepresentable) {
+    std::vector<uint8_t> values{ 0, 1, 2, 255 };
+    booleval::tree::column_visitor::column_map columns{
+        { "field_a", booleval::column(values.data(), values.size()) }
+    };
+
+    EXPECT_EQ(to_string(evaluate("field_a gt 1.5", columns)), "0011");
+    EXPECT_EQ(to_string(evaluate("field_a lt 256", columns)), "1111");
+    EXPECT_EQ(to_string(evaluate("field_a gt -1", columns)), "1111");
+    EXPECT_EQ(to_string(evaluate("field_a 1.0", columns)), "0100");
+    EXPECT_EQ(to_string(evaluate("field_a foo", columns)), "0000");
+    EXPECT_EQ(to_string(evaluate("field_a neq foo", columns)), "1111");
+}
+
+TEST_F(ColumnVisitorTest, StringColumns) {
+    std::vector<std::string> values{ "bar", "baz", "foo" };
+    booleval::tree::column_visitor::column_map columns{
+        { "field_a", booleval::column(values.data(), values.size()) }
+    };
+
+    EXPECT_EQ(to_string(evaluate("field_a foo", columns)), "001");
+    EXPECT_EQ(to_string(evaluate("field_a gt bar", columns)), "011");
+    EXPECT_EQ(to_string(evaluate("field_a \"baz\"", columns)), "010");
+}
+
+TEST_F(ColumnVisitorTest, StridedColumns) {
+    struct record {
+        float value;
+        std::string_view name;
+    };
+
+    std::vector<record> records{ { 0.5F, "one" }, { 1.5F, "two" }, { 2.5F, "three" } };
+    booleval::tree::column_visitor::column_map columns{
+        { "value", booleval::column(&records[0].value, records.size(), sizeof(record)) },
+        { "name",  booleval::column(&records[0].name,  records.size(), sizeof(record)) }
+    };
+
+    EXPECT_EQ(to_string(evaluate("value gt 1 and name neq three", columns)), "010");
+    EXPECT_EQ(to_string(evaluate("value 0.5 or name three", columns)), "101");
+}
+
+TEST_F(ColumnVisitorTest, LogicalOperations) {
+    std::vector<int64_t> field_a;
+    std::vector<double> field_b;
+    for (int64_t i = 0; i < 10000; ++i) {
+        field_a.push_back(i);
+        field_b.push_back(static_cast<double>(i % 7));
+    }
+
+    booleval::tree::column_visitor::column_map columns{
+        { "field_a", booleval::column(field_a.data(), field_a.size()) },
+        { "field_b", booleval::column(field_b.data(), field_b.size()) }
+    };
+
+    for (auto const mode : { booleval::tree::evaluation_mode::short_circuit,
+                             booleval::tree::evaluation_mode::eager }) {
+        visitor_.mode(mode);
+
+        auto const result = evaluate("field_a lt 5000 and field_b 3 or field_a geq 9990", columns);
+        ASSERT_EQ(result.size(), 10000U);
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            auto const expected = (i < 5000 && i % 7 == 3) || i >= 9990;
+            EXPECT_EQ(result.test(i), expected);
+        }
+
+        EXPECT_EQ(evaluate("field_a lt 0 and field_b 3", columns).count(), 0U);
+        EXPECT_EQ(evaluate("field_a geq 0 or field_b 3", columns).count(), 10000U);
+    }
+}
+
+TEST_F(ColumnVisitorTest, InvalidColumns) {
+    std::vector<int32_t> field_a{ 1, 2, 3 };
+    std::vector<int32_t> field_b{ 1, 2 };
+
+    booleval::tree::column_visitor::column_map columns{
+        { "field_a", booleval::column(field_a.data(), field_a.size()) }
+    };
+    EXPECT_THROW(evaluate("field_b 1", columns), booleval::field_not_found);
+
+    columns.emplace("field_b", booleval::column(field_b.data(), field_b.size()));
+    EXPECT_THROW(evaluate("field_a 1", columns), booleval::column_size_mismatch);
+}
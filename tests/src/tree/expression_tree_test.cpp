@@ -89,3 +89,29 @@ TEST_F(ExpressionTreeTest, Parentheses) {
     EXPECT_TRUE(tree.build("(field_a foo or field_b bar)"));
     EXPECT_NE(tree.root(), nullptr);
 }
+
+TEST_F(ExpressionTreeTest, LiteralValues) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+
+    EXPECT_TRUE(tree.build("field_a 1 and field_b -1.5 or field_c foo or field_d true"));
+
+    auto root = tree.root();
+    ASSERT_NE(root, nullptr);
+
+    auto const& field_d = tree.node(root->right);
+    auto const& field_c = tree.node(tree.node(root->left).right);
+    auto const& field_a = tree.node(tree.node(tree.node(root->left).left).left);
+    auto const& field_b = tree.node(tree.node(tree.node(root->left).left).right);
+
+    EXPECT_EQ(tree.node(field_a.left).token.value(), "field_a");
+    EXPECT_TRUE(tree.literal(tree.node(field_a.left)).empty());
+    EXPECT_EQ(tree.literal(tree.node(field_a.right)), 1);
+
+    EXPECT_EQ(tree.literal(tree.node(field_b.right)), -1.5);
+    EXPECT_TRUE(tree.literal(tree.node(field_c.right)).is_string());
+    EXPECT_EQ(tree.literal(tree.node(field_c.right)), "foo");
+    EXPECT_EQ(tree.literal(tree.node(field_d.right)), true);
+    EXPECT_EQ(tree.nodes().size(), 15U);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/tree/node_profiler.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+class NodeProfilerTest : public testing::Test {};
+
+TEST_F(NodeProfilerTest, EmptyTree) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    tree::node_profiler profiler(0);
+    EXPECT_TRUE(profiler.report(tree, "").empty());
+}
+
+TEST_F(NodeProfilerTest, ReportPositions) {
+    using namespace booleval;
+
+    std::string_view const expression{ "(field_a \"foo bar\" or field_b gt 1) and field_c lt 2" };
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build(expression));
+
+    tree::node_profiler const profiler(tree.nodes().size());
+    auto const report = profiler.report(tree, expression);
+    ASSERT_EQ(report.size(), 5U);
+
+    EXPECT_EQ(report[0].type, token::token_type::logical_and);
+    EXPECT_EQ(report[0].text, "field_a \"foo bar\" or field_b gt 1) and field_c lt 2");
+    EXPECT_EQ(report[1].type, token::token_type::logical_or);
+    EXPECT_EQ(report[1].text, "field_a \"foo bar\" or field_b gt 1");
+    EXPECT_EQ(report[2].type, token::token_type::eq);
+    EXPECT_EQ(report[2].text, "field_a \"foo bar\"");
+    EXPECT_EQ(report[3].type, token::token_type::gt);
+    EXPECT_EQ(report[3].text, "field_b gt 1");
+    EXPECT_EQ(report[4].type, token::token_type::lt);
+    EXPECT_EQ(report[4].text, "field_c lt 2");
+
+    for (auto const& statistics : report) {
+        EXPECT_EQ(expression.substr(statistics.begin, statistics.end - statistics.begin), statistics.text);
+        EXPECT_EQ(statistics.evaluations, 0U);
+        EXPECT_EQ(statistics.selectivity(), 0.0);
+        EXPECT_EQ(statistics.mean_accessor_nanoseconds(), 0.0);
+    }
+}
+
+TEST_F(NodeProfilerTest, RecordAndReset) {
+    using namespace booleval;
+
+    std::string_view const expression{ "field_a gt 1" };
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build(expression));
+
+    auto const root = tree.index_of(*tree.root());
+    tree::node_profiler const profiler(tree.nodes().size());
+
+    EXPECT_TRUE(profiler.timed(root));
+    profiler.record(root, 1, 1);
+    EXPECT_FALSE(profiler.timed(root));
+    profiler.record(root, tree::node_profiler::timing_period - 1, 0);
+    EXPECT_TRUE(profiler.timed(root));
+
+    profiler.record_time(root, 30);
+    profiler.record_time(root, 50);
+
+    auto report = profiler.report(tree, expression);
+    ASSERT_EQ(report.size(), 1U);
+    EXPECT_EQ(report[0].text, expression);
+    EXPECT_EQ(report[0].evaluations, tree::node_profiler::timing_period);
+    EXPECT_EQ(report[0].satisfied, 1U);
+    EXPECT_DOUBLE_EQ(report[0].selectivity(), 1.0 / tree::node_profiler::timing_period);
+    EXPECT_EQ(report[0].timed_evaluations, 2U);
+    EXPECT_DOUBLE_EQ(report[0].mean_accessor_nanoseconds(), 40.0);
+
+    profiler.reset();
+    report = profiler.report(tree, expression);
+    ASSERT_EQ(report.size(), 1U);
+    EXPECT_EQ(report[0].evaluations, 0U);
+    EXPECT_EQ(report[0].timed_evaluations, 0U);
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <booleval/tree/program.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+class ProgramTest : public testing::Test {};
+
+TEST_F(ProgramTest, DefaultConstructor) {
+    using namespace booleval;
+
+    tree::program program;
+    EXPECT_TRUE(program.empty());
+    EXPECT_TRUE(program.constants().empty());
+}
+
+TEST_F(ProgramTest, EmptyTree) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    tree::program program;
+
+    program.compile(tree);
+    EXPECT_TRUE(program.empty());
+}
+
+TEST_F(ProgramTest, RelationalOperation) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("field_a gt 1"));
+    tree.node(tree.root()->left).field_index = 3;
+
+    tree::program program;
+    program.compile(tree);
+
+    auto const& instructions = program.instructions();
+    ASSERT_EQ(instructions.size(), 2U);
+
+    EXPECT_EQ(instructions[0].code, tree::opcode::load_field);
+    EXPECT_EQ(instructions[0].operand, 3U);
+
+    EXPECT_EQ(instructions[1].code, tree::opcode::compare);
+    EXPECT_EQ(instructions[1].relation, token::token_type::gt);
+    EXPECT_EQ(instructions[1].operand, 0U);
+
+    ASSERT_EQ(program.constants().size(), 1U);
+    EXPECT_EQ(program.constants()[0].text, "1");
+    EXPECT_EQ(program.constants()[0].value, 1);
+}
+
+TEST_F(ProgramTest, LogicalOperations) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("field_a 1 and field_b 2 or field_c 3"));
+
+    tree::program program;
+    program.compile(tree);
+
+    auto const& instructions = program.instructions();
+    ASSERT_EQ(instructions.size(), 8U);
+
+    // AND jumps over its right operand straight to the right operand of OR
+    EXPECT_EQ(instructions[2].code, tree::opcode::jump_if_false);
+    EXPECT_EQ(instructions[2].operand, 3U);
+
+    // OR jumps to the end of the program
+    EXPECT_EQ(instructions[5].code, tree::opcode::jump_if_true);
+    EXPECT_EQ(instructions[5].operand, 2U);
+
+    EXPECT_EQ(program.constants().size(), 3U);
+}
+
+TEST_F(ProgramTest, ThreadedJumps) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("field_a 1 and field_b 2 and field_c 3"));
+
+    tree::program program;
+    program.compile(tree);
+
+    auto const& instructions = program.instructions();
+    ASSERT_EQ(instructions.size(), 8U);
+
+    // Both jumps lead straight to the end of the program
+    EXPECT_EQ(instructions[2].code, tree::opcode::jump_if_false);
+    EXPECT_EQ(instructions[2].operand, 5U);
+    EXPECT_EQ(instructions[5].code, tree::opcode::jump_if_false);
+    EXPECT_EQ(instructions[5].operand, 2U);
+}
+
+TEST_F(ProgramTest, ProfiledProgram) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("field_a 1 and field_b 2 and field_c 3"));
+
+    tree::program program;
+    program.compile(tree, true);
+    EXPECT_TRUE(program.profiled());
+
+    auto const& instructions = program.instructions();
+    ASSERT_EQ(instructions.size(), 13U);
+
+    // Jumps are not threaded, so they lead to the end of the nested operation
+    EXPECT_EQ(instructions[3].code, tree::opcode::jump_if_false);
+    EXPECT_EQ(instructions[3].operand, 3U);
+    EXPECT_EQ(instructions[7].code, tree::opcode::record_result);
+    EXPECT_EQ(instructions[8].code, tree::opcode::jump_if_false);
+    EXPECT_EQ(instructions[8].operand, 3U);
+
+    // Each operation records its result right after it is evaluated
+    for (std::size_t pc : { 2U, 6U, 7U, 11U, 12U }) {
+        EXPECT_EQ(instructions[pc].code, tree::opcode::record_result);
+        EXPECT_EQ(instructions[pc].operand, program.node(pc));
+    }
+    EXPECT_EQ(program.node(0), program.node(2));
+    EXPECT_EQ(instructions[12].operand, tree.index_of(*tree.root()));
+
+    program.compile(tree);
+    EXPECT_FALSE(program.profiled());
+    EXPECT_EQ(program.instructions().size(), 8U);
+}
+
+TEST_F(ProgramTest, Recompile) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    tree::program program;
+
+    ASSERT_TRUE(tree.build("field_a 1 and field_b 2"));
+    program.compile(tree);
+    EXPECT_EQ(program.instructions().size(), 5U);
+
+    ASSERT_TRUE(tree.build("field_a 1"));
+    program.compile(tree);
+    EXPECT_EQ(program.instructions().size(), 2U);
+    EXPECT_EQ(program.constants().size(), 1U);
+
+    program.clear();
+    EXPECT_TRUE(program.empty());
+    EXPECT_TRUE(program.constants().empty());
+}
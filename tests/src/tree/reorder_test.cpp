@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string>
+#include <vector>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/tree/reorder.hpp>
+#include <booleval/tree/node_profiler.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+class ReorderTest : public testing::Test {
+protected:
+    /**
+     * Finds the relational operation on the field.
+     */
+    booleval::tree::node_index find(booleval::tree::expression_tree const& tree, std::string_view const field) const {
+        auto const& nodes = tree.nodes();
+        for (booleval::tree::node_index i = 0; i < nodes.size(); ++i) {
+            auto const& node = nodes[i];
+            if (booleval::tree::null_node != node.left && tree.node(node.left).token.value() == field) {
+                return i;
+            }
+        }
+        return booleval::tree::null_node;
+    }
+
+    /**
+     * Records the evaluations of the relational operation on the field, each taking 10 ns.
+     */
+    void record(booleval::tree::expression_tree const& tree,
+                booleval::tree::node_profiler const& profiler,
+                std::string_view const field,
+                uint64_t const evaluations,
+                uint64_t const satisfied) const {
+        auto const index = find(tree, field);
+        profiler.record(index, evaluations, satisfied);
+        profiler.record_time(index, 10);
+    }
+
+    /**
+     * Gets the fields of the relational operations in the order of evaluation.
+     */
+    std::vector<std::string> order(booleval::tree::expression_tree const& tree) const {
+        std::vector<std::string> fields;
+        collect(tree, *tree.root(), fields);
+        return fields;
+    }
+
+private:
+    void collect(booleval::tree::expression_tree const& tree,
+                 booleval::tree::tree_node const& node,
+                 std::vector<std::string>& fields) const {
+        if (node.token.is_one_of(booleval::token::token_type::logical_and, booleval::token::token_type::logical_or)) {
+            collect(tree, tree.node(node.left), fields);
+            collect(tree, tree.node(node.right), fields);
+        } else {
+            fields.emplace_back(tree.node(node.left).token.value());
+        }
+    }
+};
+
+TEST_F(ReorderTest, NothingToReorder) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    tree::node_profiler const empty(0);
+    EXPECT_FALSE(tree::reorder_operands(tree, empty));
+
+    ASSERT_TRUE(tree.build("field_a eq 1"));
+    tree::node_profiler const profiler(tree.nodes().size());
+    record(tree, profiler, "field_a", 100, 10);
+    EXPECT_FALSE(tree::reorder_operands(tree, profiler));
+    EXPECT_EQ(order(tree), (std::vector<std::string>{ "field_a" }));
+}
+
+TEST_F(ReorderTest, ReorderAnd) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("field_a eq 1 and field_b eq 2 and field_c eq 3"));
+
+    tree::node_profiler const profiler(tree.nodes().size());
+    record(tree, profiler, "field_a", 100, 90);
+    record(tree, profiler, "field_b", 90, 10);
+    record(tree, profiler, "field_c", 10, 5);
+
+    EXPECT_TRUE(tree::reorder_operands(tree, profiler));
+    EXPECT_EQ(order(tree), (std::vector<std::string>{ "field_b", "field_c", "field_a" }));
+    EXPECT_EQ(tree.root()->token.type(), token::token_type::logical_and);
+
+    // Same statistics keep the order
+    EXPECT_FALSE(tree::reorder_operands(tree, profiler));
+    EXPECT_EQ(order(tree), (std::vector<std::string>{ "field_b", "field_c", "field_a" }));
+}
+
+TEST_F(ReorderTest, ReorderNestedOperations) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("field_a eq 1 or (field_b eq 2 and field_c eq 3) or field_d eq 4"));
+
+    tree::node_profiler const profiler(tree.nodes().size());
+    record(tree, profiler, "field_a", 100, 1);
+    record(tree, profiler, "field_b", 99, 60);
+    record(tree, profiler, "field_c", 60, 10);
+    record(tree, profiler, "field_d", 89, 80);
+    profiler.record(tree.node(tree.root()->left).right, 99, 10);
+
+    EXPECT_TRUE(tree::reorder_operands(tree, profiler));
+    EXPECT_EQ(order(tree), (std::vector<std::string>{ "field_d", "field_c", "field_b", "field_a" }));
+}
+
+TEST_F(ReorderTest, UnevaluatedOperandsKeepOrder) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("field_a eq 1 and (field_b eq 2 and field_c eq 3)"));
+
+    tree::node_profiler const profiler(tree.nodes().size());
+    EXPECT_FALSE(tree::reorder_operands(tree, profiler));
+
+    // Right-nested chain is rebuilt as a left-deep one
+    EXPECT_EQ(tree.node(tree.root()->right).token.type(), token::token_type::eq);
+    EXPECT_EQ(order(tree), (std::vector<std::string>{ "field_a", "field_b", "field_c" }));
+
+    record(tree, profiler, "field_a", 100, 100);
+    record(tree, profiler, "field_b", 100, 50);
+    EXPECT_TRUE(tree::reorder_operands(tree, profiler));
+    EXPECT_EQ(order(tree), (std::vector<std::string>{ "field_b", "field_a", "field_c" }));
+}
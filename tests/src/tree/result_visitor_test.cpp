@@ -27,8 +27,10 @@
  *
  */
 
+#include <vector>
 #include <gtest/gtest.h>
 #include <booleval/tree/tree_node.hpp>
+#include <booleval/tree/expression_tree.hpp>
 #include <booleval/token/token_type.hpp>
 #include <booleval/tree/result_visitor.hpp>
 
@@ -60,16 +62,33 @@ public:
         U value_b_;
     };
 
-    std::shared_ptr<booleval::tree::tree_node>
+    class counting_obj {
+    public:
+        counting_obj(uint8_t value, std::size_t& calls) : value_{ value }, calls_{ &calls } {}
+        uint8_t value_a() const noexcept { ++*calls_; return value_; }
+
+    private:
+        uint8_t value_;
+        std::size_t* calls_;
+    };
+
+    booleval::tree::node_index
     make_tree_node(booleval::token::token_type const type) {
-        return std::make_shared<booleval::tree::tree_node>(type);
+        return tree_.add_node(type);
     }
 
-    std::shared_ptr<booleval::tree::tree_node>
+    booleval::tree::node_index
     make_tree_node(booleval::token::token_type const type, std::string_view const value) {
         booleval::token::token t(type, value);
-        return std::make_shared<booleval::tree::tree_node>(t);
+        return tree_.add_node(t);
     }
+
+    booleval::tree::tree_node& node(booleval::tree::node_index const index) {
+        return tree_.node(index);
+    }
+
+protected:
+    booleval::tree::expression_tree tree_;
 };
 
 TEST_F(ResultVisitorTest, VisitAndTreeNode) {
@@ -91,23 +110,23 @@ TEST_F(ResultVisitorTest, VisitAndTreeNode) {
     auto op    = make_tree_node(token::token_type::eq);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    and_op->left = op;
+    node(and_op).left = op;
 
     left  = make_tree_node(token::token_type::field, "field_b");
     op    = make_tree_node(token::token_type::eq);
     right = make_tree_node(token::token_type::field, "2");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    and_op->right = op;
+    node(and_op).right = op;
 
-    EXPECT_TRUE(visitor.visit(*and_op, foo));
-    EXPECT_FALSE(visitor.visit(*and_op, bar));
-    EXPECT_FALSE(visitor.visit(*and_op, baz));
+    EXPECT_TRUE(visitor.visit(tree_, node(and_op), foo));
+    EXPECT_FALSE(visitor.visit(tree_, node(and_op), bar));
+    EXPECT_FALSE(visitor.visit(tree_, node(and_op), baz));
 }
 
 TEST_F(ResultVisitorTest, VisitOrTreeNode) {
@@ -128,23 +147,100 @@ TEST_F(ResultVisitorTest, VisitOrTreeNode) {
     auto op    = make_tree_node(token::token_type::eq);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    or_op->left = op;
+    node(or_op).left = op;
 
     left  = make_tree_node(token::token_type::field, "field_a");
     op    = make_tree_node(token::token_type::eq);
     right = make_tree_node(token::token_type::field, "2");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
+
+    node(or_op).right = op;
+
+    EXPECT_TRUE(visitor.visit(tree_, node(or_op), foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(or_op), bar));
+    EXPECT_FALSE(visitor.visit(tree_, node(or_op), baz));
+}
+
+TEST_F(ResultVisitorTest, ShortCircuitEvaluation) {
+    using namespace booleval;
+
+    std::size_t calls{ 0 };
+    counting_obj foo{ 1, calls };
+    counting_obj bar{ 2, calls };
+
+    tree::result_visitor<> visitor;
+    visitor.fields({
+        { "field_a", &counting_obj::value_a }
+    });
+    EXPECT_EQ(visitor.mode(), tree::evaluation_mode::short_circuit);
+
+    auto make_eq = [this](std::string_view const value) {
+        auto op = make_tree_node(token::token_type::eq);
+        node(op).left  = make_tree_node(token::token_type::field, "field_a");
+        node(op).right = make_tree_node(token::token_type::field, value);
+        return op;
+    };
+
+    auto and_op = make_tree_node(token::token_type::logical_and);
+    node(and_op).left  = make_eq("1");
+    node(and_op).right = make_eq("2");
+
+    auto or_op = make_tree_node(token::token_type::logical_or);
+    node(or_op).left  = make_eq("1");
+    node(or_op).right = make_eq("2");
+
+    EXPECT_FALSE(visitor.visit(tree_, node(and_op), bar));
+    EXPECT_EQ(calls, 1U);
+
+    calls = 0;
+    EXPECT_TRUE(visitor.visit(tree_, node(or_op), foo));
+    EXPECT_EQ(calls, 1U);
+
+    calls = 0;
+    EXPECT_TRUE(visitor.visit(tree_, node(or_op), bar));
+    EXPECT_EQ(calls, 2U);
+}
+
+TEST_F(ResultVisitorTest, EagerEvaluation) {
+    using namespace booleval;
+
+    std::size_t calls{ 0 };
+    counting_obj foo{ 1, calls };
+    counting_obj bar{ 2, calls };
+
+    tree::result_visitor<> visitor;
+    visitor.fields({
+        { "field_a", &counting_obj::value_a }
+    });
+    visitor.mode(tree::evaluation_mode::eager);
+    EXPECT_EQ(visitor.mode(), tree::evaluation_mode::eager);
+
+    auto make_eq = [this](std::string_view const value) {
+        auto op = make_tree_node(token::token_type::eq);
+        node(op).left  = make_tree_node(token::token_type::field, "field_a");
+        node(op).right = make_tree_node(token::token_type::field, value);
+        return op;
+    };
+
+    auto and_op = make_tree_node(token::token_type::logical_and);
+    node(and_op).left  = make_eq("1");
+    node(and_op).right = make_eq("2");
 
-    or_op->right = op;
+    auto or_op = make_tree_node(token::token_type::logical_or);
+    node(or_op).left  = make_eq("1");
+    node(or_op).right = make_eq("2");
 
-    EXPECT_TRUE(visitor.visit(*or_op, foo));
-    EXPECT_TRUE(visitor.visit(*or_op, bar));
-    EXPECT_FALSE(visitor.visit(*or_op, baz));
+    EXPECT_FALSE(visitor.visit(tree_, node(and_op), bar));
+    EXPECT_EQ(calls, 2U);
+
+    calls = 0;
+    EXPECT_TRUE(visitor.visit(tree_, node(or_op), foo));
+    EXPECT_EQ(calls, 2U);
 }
 
 TEST_F(ResultVisitorTest, VisitEqualToTreeNode) {
@@ -162,11 +258,11 @@ TEST_F(ResultVisitorTest, VisitEqualToTreeNode) {
     auto op    = make_tree_node(token::token_type::eq);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    EXPECT_TRUE(visitor.visit(*op, foo));
-    EXPECT_FALSE(visitor.visit(*op, bar));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), foo));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), bar));
 }
 
 TEST_F(ResultVisitorTest, VisitNotEqualToTreeNode) {
@@ -184,11 +280,11 @@ TEST_F(ResultVisitorTest, VisitNotEqualToTreeNode) {
     auto op    = make_tree_node(token::token_type::neq);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    EXPECT_FALSE(visitor.visit(*op, foo));
-    EXPECT_TRUE(visitor.visit(*op, bar));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), bar));
 }
 
 TEST_F(ResultVisitorTest, VisitGreaterThanTreeNode) {
@@ -207,12 +303,12 @@ TEST_F(ResultVisitorTest, VisitGreaterThanTreeNode) {
     auto op    = make_tree_node(token::token_type::gt);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    EXPECT_FALSE(visitor.visit(*op, foo));
-    EXPECT_FALSE(visitor.visit(*op, bar));
-    EXPECT_TRUE(visitor.visit(*op, baz));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), foo));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), bar));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), baz));
 }
 
 TEST_F(ResultVisitorTest, VisitLessThanTreeNode) {
@@ -231,12 +327,12 @@ TEST_F(ResultVisitorTest, VisitLessThanTreeNode) {
     auto op    = make_tree_node(token::token_type::lt);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    EXPECT_TRUE(visitor.visit(*op, foo));
-    EXPECT_FALSE(visitor.visit(*op, bar));
-    EXPECT_FALSE(visitor.visit(*op, baz));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), foo));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), bar));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), baz));
 }
 
 TEST_F(ResultVisitorTest, VisitGreaterThanOrEqualTreeNode) {
@@ -255,12 +351,12 @@ TEST_F(ResultVisitorTest, VisitGreaterThanOrEqualTreeNode) {
     auto op    = make_tree_node(token::token_type::geq);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    EXPECT_FALSE(visitor.visit(*op, foo));
-    EXPECT_TRUE(visitor.visit(*op, bar));
-    EXPECT_TRUE(visitor.visit(*op, baz));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), bar));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), baz));
 }
 
 TEST_F(ResultVisitorTest, VisitLessThanOrEqualTreeNode) {
@@ -279,12 +375,12 @@ TEST_F(ResultVisitorTest, VisitLessThanOrEqualTreeNode) {
     auto op    = make_tree_node(token::token_type::leq);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left  = left;
-    op->right = right;
+    node(op).left  = left;
+    node(op).right = right;
 
-    EXPECT_TRUE(visitor.visit(*op, foo));
-    EXPECT_TRUE(visitor.visit(*op, bar));
-    EXPECT_FALSE(visitor.visit(*op, baz));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), bar));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), baz));
 }
 
 TEST_F(ResultVisitorTest, VisitInvalidTreeNode) {
@@ -302,15 +398,50 @@ TEST_F(ResultVisitorTest, VisitInvalidTreeNode) {
     auto op = make_tree_node(token::token_type::eq);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left = left;
-    op->right = right;
+    node(op).left = left;
+    node(op).right = right;
 
-    EXPECT_TRUE(visitor.visit(*op, foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(op), foo));
 
     left = make_tree_node(token::token_type::field, "field_a_notvalid");
-    op->left = left;
+    node(op).left = left;
 
-    EXPECT_FALSE(visitor.visit(*op, foo));
+    EXPECT_FALSE(visitor.visit(tree_, node(op), foo));
+}
+
+TEST_F(ResultVisitorTest, ResolveTreeNode) {
+    using namespace booleval;
+
+    multi_obj<uint8_t, uint8_t> foo{ 1, 2 };
+
+    tree::result_visitor<> visitor;
+    visitor.fields({
+        { "field_a", &multi_obj<uint8_t, uint8_t>::value_a },
+        { "field_b", &multi_obj<uint8_t, uint8_t>::value_b }
+    });
+
+    auto and_op = make_tree_node(token::token_type::logical_and);
+
+    node(and_op).left = make_tree_node(token::token_type::eq);
+    node(node(and_op).left).left  = make_tree_node(token::token_type::field, "field_a");
+    node(node(and_op).left).right = make_tree_node(token::token_type::field, "1");
+
+    node(and_op).right = make_tree_node(token::token_type::eq);
+    node(node(and_op).right).left  = make_tree_node(token::token_type::field, "field_b");
+    node(node(and_op).right).right = make_tree_node(token::token_type::field, "2");
+
+    EXPECT_EQ(node(node(node(and_op).left).left).field_index, tree::unresolved_field);
+    EXPECT_EQ(node(node(node(and_op).right).left).field_index, tree::unresolved_field);
+
+    visitor.resolve(tree_, node(and_op));
+
+    EXPECT_EQ(node(node(node(and_op).left).left).field_index, 0U);
+    EXPECT_EQ(node(node(node(and_op).right).left).field_index, 1U);
+    EXPECT_EQ(node(node(node(and_op).left).right).field_index, tree::unresolved_field);
+    EXPECT_TRUE(visitor.visit(tree_, node(and_op), foo));
+
+    node(node(and_op).right).left = make_tree_node(token::token_type::field, "field_not_exist");
+    EXPECT_THROW(visitor.resolve(tree_, node(and_op)), field_not_found);
 }
 
 TEST_F(ResultVisitorTest, VisitNonExistantTreeNode) {
@@ -327,13 +458,90 @@ TEST_F(ResultVisitorTest, VisitNonExistantTreeNode) {
     auto op = make_tree_node(token::token_type::eq);
     auto right = make_tree_node(token::token_type::field, "1");
 
-    op->left = left;
-    op->right = right;
+    node(op).left = left;
+    node(op).right = right;
 
     try {
-        [[maybe_unused]] auto result = visitor.visit(*op, foo);
+        [[maybe_unused]] auto result = visitor.visit(tree_, node(op), foo);
         FAIL() << "Expected booleval::field_not_found";
     } catch (field_not_found const& ex) {
         EXPECT_EQ(ex.what(), std::string("Field 'field_not_exist' not found"));
     }
 }
+
+TEST_F(ResultVisitorTest, RunProgram) {
+    using namespace booleval;
+
+    multi_obj<uint8_t, uint8_t> foo{ 1, 2 };
+    multi_obj<uint8_t, uint8_t> bar{ 2, 3 };
+    multi_obj<uint8_t, uint8_t> baz{ 3, 4 };
+
+    tree::result_visitor<> visitor;
+    visitor.fields({
+        { "field_a", &multi_obj<uint8_t, uint8_t>::value_a },
+        { "field_b", &multi_obj<uint8_t, uint8_t>::value_b }
+    });
+
+    tree::program program;
+    EXPECT_FALSE(visitor.run(program, foo));
+
+    ASSERT_TRUE(tree_.build("field_a 1 and field_b 2 or field_b gt 3"));
+    visitor.resolve(tree_, *tree_.root());
+    program.compile(tree_);
+
+    EXPECT_TRUE(visitor.run(program, foo));
+    EXPECT_FALSE(visitor.run(program, bar));
+    EXPECT_TRUE(visitor.run(program, baz));
+}
+
+TEST_F(ResultVisitorTest, VisitBatch) {
+    using namespace booleval;
+
+    std::size_t calls{ 0 };
+    std::vector<counting_obj> objects;
+    for (uint8_t i = 0; i < 64; ++i) {
+        objects.emplace_back(i, calls);
+    }
+
+    std::vector<counting_obj const*> pointers;
+    for (auto const& object : objects) {
+        pointers.push_back(&object);
+    }
+
+    tree::result_visitor<> visitor;
+    visitor.fields({
+        { "field_a", &counting_obj::value_a }
+    });
+
+    ASSERT_TRUE(tree_.build("field_a lt 3 or field_a gt 60"));
+    EXPECT_EQ(visitor.visit_batch(tree_, *tree_.root(), pointers.data(), utils::selection::first(5)), 0b00111U);
+    EXPECT_EQ(calls, 7U);
+
+    // Right operand of OR is evaluated only for the objects not satisfying the left one
+    calls = 0;
+    auto const mask = visitor.visit_batch(tree_, *tree_.root(), pointers.data(), utils::selection::first(64));
+    EXPECT_EQ(mask, 0b111U | (uint64_t{ 0b111 } << 61));
+    EXPECT_EQ(calls, 125U);
+
+    // Right operand of AND is evaluated only for the objects satisfying the left one
+    ASSERT_TRUE(tree_.build("field_a lt 10 and field_a gt 5"));
+    calls = 0;
+    EXPECT_EQ(visitor.visit_batch(tree_, *tree_.root(), pointers.data(), utils::selection::first(64)), 0b1111000000U);
+    EXPECT_EQ(calls, 74U);
+
+    // Objects which are not selected are never evaluated
+    calls = 0;
+    EXPECT_EQ(visitor.visit_batch(tree_, *tree_.root(), pointers.data(), utils::selection(0b1010101010)), 0b1010000000U);
+    EXPECT_EQ(calls, 10U);
+
+    visitor.mode(tree::evaluation_mode::eager);
+    calls = 0;
+    EXPECT_EQ(visitor.visit_batch(tree_, *tree_.root(), pointers.data(), utils::selection::first(64)), 0b1111000000U);
+    EXPECT_EQ(calls, 128U);
+    visitor.mode(tree::evaluation_mode::short_circuit);
+
+    ASSERT_TRUE(tree_.build("field_a gt 100 and field_a lt 3"));
+    calls = 0;
+    EXPECT_EQ(visitor.visit_batch(tree_, *tree_.root(), pointers.data(), utils::selection::first(64)), 0U);
+    EXPECT_EQ(calls, 64U);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <booleval/field.hpp>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/tree/expression_tree.hpp>
+#include <booleval/token/token_type.hpp>
+#include <booleval/tree/static_result_visitor.hpp>
+
+namespace {
+
+struct record {
+    uint8_t field_a_;
+    uint8_t field_b_;
+
+    uint8_t field_a() const noexcept { return field_a_; }
+};
+
+constexpr auto record_fields = booleval::make_fields(
+    booleval::field{ "field_a", &record::field_a },
+    booleval::field{ "field_b", &record::field_b_ }
+);
+
+} // namespace
+
+class StaticResultVisitorTest : public testing::Test {
+public:
+    booleval::tree::node_index
+    make_tree_node(booleval::token::token_type const type) {
+        return tree_.add_node(type);
+    }
+
+    booleval::tree::node_index
+    make_tree_node(booleval::token::token_type const type, std::string_view const value) {
+        booleval::token::token t(type, value);
+        return tree_.add_node(t);
+    }
+
+    booleval::tree::tree_node& node(booleval::tree::node_index const index) {
+        return tree_.node(index);
+    }
+
+    booleval::tree::node_index
+    make_relational_node(booleval::token::token_type const type, std::string_view const field, std::string_view const value) {
+        auto op = make_tree_node(type);
+        node(op).left  = make_tree_node(booleval::token::token_type::field, field);
+        node(op).right = make_tree_node(booleval::token::token_type::field, value);
+        return op;
+    }
+
+protected:
+    booleval::tree::expression_tree tree_;
+};
+
+TEST_F(StaticResultVisitorTest, VisitRelationalTreeNodes) {
+    using namespace booleval;
+
+    record foo{ 1, 2 };
+
+    tree::static_result_visitor<record, record_fields> visitor;
+
+    EXPECT_TRUE(visitor.visit(tree_, node(make_relational_node(token::token_type::eq, "field_a", "1")), foo));
+    EXPECT_FALSE(visitor.visit(tree_, node(make_relational_node(token::token_type::neq, "field_a", "1")), foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(make_relational_node(token::token_type::gt, "field_b", "1")), foo));
+    EXPECT_FALSE(visitor.visit(tree_, node(make_relational_node(token::token_type::lt, "field_b", "1")), foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(make_relational_node(token::token_type::geq, "field_b", "2")), foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(make_relational_node(token::token_type::leq, "field_a", "1.5")), foo));
+}
+
+TEST_F(StaticResultVisitorTest, VisitLogicalTreeNodes) {
+    using namespace booleval;
+
+    record foo{ 1, 2 };
+    record bar{ 2, 2 };
+
+    tree::static_result_visitor<record, record_fields> visitor;
+
+    auto and_op = make_tree_node(token::token_type::logical_and);
+    node(and_op).left  = make_relational_node(token::token_type::eq, "field_a", "1");
+    node(and_op).right = make_relational_node(token::token_type::eq, "field_b", "2");
+
+    auto or_op = make_tree_node(token::token_type::logical_or);
+    node(or_op).left  = make_relational_node(token::token_type::eq, "field_a", "3");
+    node(or_op).right = make_relational_node(token::token_type::eq, "field_a", "2");
+
+    EXPECT_TRUE(visitor.visit(tree_, node(and_op), foo));
+    EXPECT_FALSE(visitor.visit(tree_, node(and_op), bar));
+    EXPECT_FALSE(visitor.visit(tree_, node(or_op), foo));
+    EXPECT_TRUE(visitor.visit(tree_, node(or_op), bar));
+}
+
+TEST_F(StaticResultVisitorTest, ResolveTreeNode) {
+    using namespace booleval;
+
+    record foo{ 1, 2 };
+
+    tree::static_result_visitor<record, record_fields> visitor;
+
+    auto and_op = make_tree_node(token::token_type::logical_and);
+    node(and_op).left  = make_relational_node(token::token_type::eq, "field_a", "1");
+    node(and_op).right = make_relational_node(token::token_type::eq, "field_b", "2");
+
+    visitor.resolve(tree_, node(and_op));
+
+    EXPECT_EQ(node(node(node(and_op).left).left).field_index, 0U);
+    EXPECT_EQ(node(node(node(and_op).right).left).field_index, 1U);
+    EXPECT_TRUE(visitor.visit(tree_, node(and_op), foo));
+
+    node(node(and_op).right).left = make_tree_node(token::token_type::field, "field_not_exist");
+    EXPECT_THROW(visitor.resolve(tree_, node(and_op)), field_not_found);
+}
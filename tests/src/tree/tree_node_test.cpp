@@ -39,8 +39,8 @@ TEST_F(TreeNodeTest, DefaultConstructor) {
 
     tree::tree_node node;
     EXPECT_EQ(node.token.type(), token::token_type::unknown);
-    EXPECT_EQ(node.left, nullptr);
-    EXPECT_EQ(node.right, nullptr);
+    EXPECT_EQ(node.left, tree::null_node);
+    EXPECT_EQ(node.right, tree::null_node);
 }
 
 TEST_F(TreeNodeTest, ConstructorFromTokenType) {
@@ -48,8 +48,8 @@ TEST_F(TreeNodeTest, ConstructorFromTokenType) {
 
     tree::tree_node node(token::token_type::logical_and);
     EXPECT_EQ(node.token.type(), token::token_type::logical_and);
-    EXPECT_EQ(node.left, nullptr);
-    EXPECT_EQ(node.right, nullptr);
+    EXPECT_EQ(node.left, tree::null_node);
+    EXPECT_EQ(node.right, tree::null_node);
 }
 
 TEST_F(TreeNodeTest, ConstructorFromToken) {
@@ -58,8 +58,8 @@ TEST_F(TreeNodeTest, ConstructorFromToken) {
     token::token and_token(token::token_type::logical_and);
     tree::tree_node node(and_token);
     EXPECT_EQ(node.token.type(), token::token_type::logical_and);
-    EXPECT_EQ(node.left, nullptr);
-    EXPECT_EQ(node.right, nullptr);
+    EXPECT_EQ(node.left, tree::null_node);
+    EXPECT_EQ(node.right, tree::null_node);
 }
 
 TEST_F(TreeNodeTest, ConstructorFromFieldToken) {
@@ -69,6 +69,6 @@ TEST_F(TreeNodeTest, ConstructorFromFieldToken) {
     tree::tree_node node(field_token);
     EXPECT_EQ(node.token.value(), "foo");
     EXPECT_EQ(node.token.type(), token::token_type::field);
-    EXPECT_EQ(node.left, nullptr);
-    EXPECT_EQ(node.right, nullptr);
+    EXPECT_EQ(node.left, tree::null_node);
+    EXPECT_EQ(node.right, tree::null_node);
 }
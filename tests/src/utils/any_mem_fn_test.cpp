@@ -44,6 +44,18 @@ public:
     private:
         T value_;
     };
+
+    class non_copyable_obj {
+    public:
+        non_copyable_obj(std::string value) : value_{ std::move(value) } {}
+        non_copyable_obj(non_copyable_obj const&) = delete;
+        non_copyable_obj& operator=(non_copyable_obj const&) = delete;
+        std::string const& value() const noexcept { return value_; }
+        std::string const& mutable_value() noexcept { return value_; }
+
+    private:
+        std::string value_;
+    };
 };
 
 TEST_F(AnyMemFnTest, IntValue) {
@@ -121,3 +133,42 @@ TEST_F(AnyMemFnTest, FloatingPointComparisons) {
     EXPECT_TRUE(fn.invoke(foo) <= 1.234567F);
     EXPECT_TRUE(fn.invoke(foo) <= 2.345678F);
 }
+
+TEST_F(AnyMemFnTest, ObjectNotCopied) {
+    using namespace booleval::utils;
+
+    non_copyable_obj foo{ "abc" };
+    any_mem_fn fn{ &non_copyable_obj::value };
+    any_mem_fn mutable_fn{ &non_copyable_obj::mutable_value };
+
+    EXPECT_EQ(fn.invoke(foo), "abc");
+    EXPECT_EQ(mutable_fn.invoke(foo), "abc");
+}
+
+TEST_F(AnyMemFnTest, PointerToObject) {
+    using namespace booleval::utils;
+
+    obj<uint8_t> foo{ 1 };
+    obj<uint8_t> const* ptr{ &foo };
+    obj<uint8_t> const* null_ptr{ nullptr };
+    any_mem_fn fn{ &obj<uint8_t>::value };
+
+    EXPECT_EQ(fn.invoke(&foo), 1U);
+    EXPECT_EQ(fn.invoke(ptr), 1U);
+    EXPECT_TRUE(fn.invoke(null_ptr).empty());
+}
+
+TEST_F(AnyMemFnTest, DifferentClass) {
+    using namespace booleval::utils;
+
+    obj<uint8_t> foo{ 1 };
+    obj<uint16_t> bar{ 1 };
+    any_mem_fn fn{ &obj<uint8_t>::value };
+    any_mem_fn empty_fn;
+
+    EXPECT_EQ(fn.class_id(), type_id_of<obj<uint8_t>>());
+    EXPECT_EQ(empty_fn.class_id(), nullptr);
+
+    EXPECT_TRUE(fn.invoke(bar).empty());
+    EXPECT_TRUE(empty_fn.invoke(foo).empty());
+}
@@ -27,6 +27,7 @@
  *
  */
 
+#include <limits>
 #include <string>
 #include <string_view>
 #include <gtest/gtest.h>
@@ -109,3 +110,148 @@ TEST_F(AnyValueTest, FloatingPointComparisons) {
     EXPECT_TRUE(value <= 1.234567F);
     EXPECT_TRUE(value <= 2.345678F);
 }
+
+TEST_F(AnyValueTest, EmptyValue) {
+    using namespace booleval::utils;
+
+    any_value value;
+    EXPECT_TRUE(value.empty());
+    EXPECT_FALSE(value.is_string());
+
+    EXPECT_FALSE(value == 1U);
+    EXPECT_TRUE(value != 1U);
+    EXPECT_FALSE(value > 1U);
+    EXPECT_FALSE(value <= 1U);
+    EXPECT_EQ(compare(value, value), comparison_result::unordered);
+}
+
+TEST_F(AnyValueTest, MixedSignednessComparisons) {
+    using namespace booleval::utils;
+
+    any_value value{ -1 };
+
+    EXPECT_TRUE(value < 0U);
+    EXPECT_TRUE(value != 18446744073709551615ULL);
+    EXPECT_TRUE(any_value{ 18446744073709551615ULL } > -1);
+    EXPECT_TRUE(any_value{ uint32_t{ 100 } } == int8_t{ 100 });
+}
+
+TEST_F(AnyValueTest, MixedPrecisionComparisons) {
+    using namespace booleval::utils;
+
+    any_value value{ 1.24F };
+
+    EXPECT_TRUE(value == 1.24);
+    EXPECT_TRUE(value == "1.24");
+    EXPECT_TRUE(value > 1);
+    EXPECT_TRUE(any_value{ 2 } > 1.5);
+    EXPECT_TRUE(any_value{ 2 } < "2.5");
+}
+
+TEST_F(AnyValueTest, ExactIntegerToFloatingPointComparisons) {
+    using namespace booleval::utils;
+
+    // Integers beyond the precision of the floating point type are not rounded
+    EXPECT_TRUE(any_value{ uint64_t{ 9007199254740993ULL } } > 9007199254740992.0);
+    EXPECT_TRUE(any_value{ 9007199254740992.0 } < int64_t{ 9007199254740993LL });
+    EXPECT_TRUE(any_value{ std::numeric_limits<int64_t>::max() } < 9223372036854775808.0);
+    EXPECT_TRUE(any_value{ std::numeric_limits<uint64_t>::max() } < 18446744073709551616.0);
+    EXPECT_TRUE(any_value{ std::numeric_limits<int64_t>::min() } == -9223372036854775808.0);
+    EXPECT_TRUE(any_value{ 16777216.0F } < 16777217);
+    EXPECT_TRUE(any_value{ 16777216.0F } == 16777216);
+
+    // Fractions decide between equal integral parts
+    EXPECT_TRUE(any_value{ 2 } < 2.5);
+    EXPECT_TRUE(any_value{ -2 } > -2.5);
+    EXPECT_TRUE(any_value{ 0U } > -0.5);
+    EXPECT_TRUE(any_value{ 0U } == -0.0);
+    EXPECT_TRUE(any_value{ true } < 1.5F);
+
+    EXPECT_EQ(compare_arithmetic(uint64_t{ 1 }, std::numeric_limits<double>::quiet_NaN()), comparison_result::unordered);
+    EXPECT_EQ(compare_arithmetic(std::numeric_limits<float>::infinity(), int64_t{ 1 }), comparison_result::greater);
+    EXPECT_EQ(compare_arithmetic(-std::numeric_limits<float>::infinity(), uint64_t{ 1 }), comparison_result::less);
+}
+
+TEST_F(AnyValueTest, NaNComparisons) {
+    using namespace booleval::utils;
+
+    any_value value{ std::numeric_limits<double>::quiet_NaN() };
+
+    EXPECT_FALSE(value == 1.0);
+    EXPECT_TRUE(value != 1.0);
+    EXPECT_FALSE(value < 1.0);
+    EXPECT_FALSE(value >= 1.0);
+}
+
+TEST_F(AnyValueTest, BoolComparisons) {
+    using namespace booleval::utils;
+
+    any_value value{ true };
+
+    EXPECT_TRUE(value == true);
+    EXPECT_TRUE(value == 1);
+    EXPECT_TRUE(value == "1");
+    EXPECT_TRUE(value > false);
+}
+
+TEST_F(AnyValueTest, StringComparisons) {
+    using namespace booleval::utils;
+
+    any_value value{ std::string{ "30" } };
+    EXPECT_TRUE(value.is_string());
+
+    EXPECT_TRUE(value == "30");
+    EXPECT_TRUE(value > "200");
+    EXPECT_TRUE(value < "4");
+    EXPECT_TRUE(value >= std::string_view{ "30" });
+    EXPECT_TRUE(value <= std::string{ "30" });
+
+    EXPECT_FALSE(value == 30);
+    EXPECT_TRUE(value != 30);
+    EXPECT_EQ(compare(value, any_value{ 30 }), comparison_result::unordered);
+}
+
+TEST_F(AnyValueTest, NonArithmeticText) {
+    using namespace booleval::utils;
+
+    any_value value{ 1 };
+
+    EXPECT_FALSE(value == "foo");
+    EXPECT_TRUE(value != "foo");
+    EXPECT_FALSE(value > "foo");
+    EXPECT_FALSE(value < "1foo");
+}
+
+TEST_F(AnyValueTest, ParseArithmetic) {
+    using namespace booleval::utils;
+
+    EXPECT_EQ(parse_arithmetic("-1"), -1);
+    EXPECT_EQ(parse_arithmetic("18446744073709551615"), 18446744073709551615ULL);
+    EXPECT_EQ(parse_arithmetic("1.5"), 1.5);
+    EXPECT_TRUE(parse_arithmetic("1.5foo").empty());
+    EXPECT_TRUE(parse_arithmetic("foo").empty());
+    EXPECT_TRUE(parse_arithmetic("").empty());
+
+    // Only decimal notation is accepted, whichever standard library parses the text
+    EXPECT_EQ(parse_arithmetic("-1.5e3"), -1500.0);
+    EXPECT_EQ(parse_arithmetic(".5"), 0.5);
+    EXPECT_TRUE(parse_arithmetic("nan").empty());
+    EXPECT_TRUE(parse_arithmetic("inf").empty());
+    EXPECT_TRUE(parse_arithmetic("0x10").empty());
+    EXPECT_TRUE(parse_arithmetic("+1").empty());
+    EXPECT_TRUE(parse_arithmetic("1e").empty());
+    EXPECT_TRUE(parse_arithmetic(" 1").empty());
+    EXPECT_TRUE(parse_value("nan").is_string());
+    EXPECT_TRUE(parse_value("0x10").is_string());
+}
+
+TEST_F(AnyValueTest, ParseValue) {
+    using namespace booleval::utils;
+
+    EXPECT_EQ(parse_value("true"), true);
+    EXPECT_EQ(parse_value("FALSE"), false);
+    EXPECT_EQ(parse_value("42"), 42);
+    EXPECT_EQ(parse_value("4.2"), 4.2);
+    EXPECT_TRUE(parse_value("foo").is_string());
+    EXPECT_EQ(parse_value("foo"), "foo");
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <booleval/utils/bitmap.hpp>
+
+class BitmapTest : public testing::Test {};
+
+TEST_F(BitmapTest, DefaultConstructor) {
+    using namespace booleval::utils;
+
+    bitmap bits;
+    EXPECT_EQ(bits.size(), 0U);
+    EXPECT_EQ(bits.words(), 0U);
+    EXPECT_EQ(bits.count(), 0U);
+}
+
+TEST_F(BitmapTest, ConstructorFromSize) {
+    using namespace booleval::utils;
+
+    bitmap bits(130);
+    EXPECT_EQ(bits.size(), 130U);
+    EXPECT_EQ(bits.words(), 3U);
+    EXPECT_EQ(bits.count(), 0U);
+}
+
+TEST_F(BitmapTest, SetAndTest) {
+    using namespace booleval::utils;
+
+    bitmap bits(100);
+    bits.set(0);
+    bits.set(63);
+    bits.set(64);
+    bits.set(99);
+    EXPECT_TRUE(bits.test(0));
+    EXPECT_FALSE(bits.test(1));
+    EXPECT_TRUE(bits.test(63));
+    EXPECT_TRUE(bits.test(64));
+    EXPECT_TRUE(bits.test(99));
+    EXPECT_EQ(bits.count(), 4U);
+
+    bits.set(63, false);
+    EXPECT_FALSE(bits.test(63));
+    EXPECT_EQ(bits.count(), 3U);
+    EXPECT_EQ(bits.word(0), 1U);
+    EXPECT_EQ(bits.word(1), (uint64_t{ 1 } << 35) | 1U);
+}
+
+TEST_F(BitmapTest, Words) {
+    using namespace booleval::utils;
+
+    bitmap bits(70);
+    bits.word(0, ~uint64_t{ 0 });
+    bits.word(1, 0x3F);
+    EXPECT_EQ(bits.count(), 70U);
+    EXPECT_TRUE(bits.test(69));
+
+    bits.reset();
+    EXPECT_EQ(bits.count(), 0U);
+    EXPECT_EQ(bits.size(), 70U);
+}
+
+TEST_F(BitmapTest, Resize) {
+    using namespace booleval::utils;
+
+    bitmap bits(10);
+    bits.set(5);
+
+    bits.resize(200);
+    EXPECT_EQ(bits.size(), 200U);
+    EXPECT_EQ(bits.words(), 4U);
+    EXPECT_EQ(bits.count(), 0U);
+}
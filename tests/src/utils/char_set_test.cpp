@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/utils/char_set.hpp>
+#include <booleval/utils/instruction_set.hpp>
+
+class CharSetTest : public testing::Test {
+public:
+    void TearDown() override {
+        booleval::utils::active_instruction_set(booleval::utils::supported_instruction_set());
+    }
+
+protected:
+    static constexpr booleval::utils::instruction_set instruction_sets[] = {
+        booleval::utils::instruction_set::scalar,
+        booleval::utils::instruction_set::sse42,
+        booleval::utils::instruction_set::avx2
+    };
+};
+
+TEST_F(CharSetTest, Insert) {
+    using namespace booleval;
+
+    constexpr utils::char_set set("() ");
+    static_assert(3 == set.size());
+    static_assert(set.contains('('));
+    static_assert(set.contains(' '));
+    static_assert(!set.contains('a'));
+
+    utils::char_set other;
+    EXPECT_TRUE(other.empty());
+    other.insert("aab");
+    other.insert('\xff');
+    EXPECT_EQ(other.size(), 3U);
+    EXPECT_TRUE(other.contains('\xff'));
+    EXPECT_FALSE(other.contains('c'));
+}
+
+TEST_F(CharSetTest, FindFirst) {
+    using namespace booleval;
+
+    std::string text(200, 'x');
+    for (std::string_view const set_chars : { "\"", "() \"", "0123456789" }) {
+        utils::char_set const set(set_chars);
+
+        for (auto const isa : instruction_sets) {
+            utils::active_instruction_set(isa);
+
+            auto const begin = text.data();
+            auto const end = text.data() + text.size();
+            EXPECT_EQ(set.find_first(begin, end), end);
+            EXPECT_EQ(set.find_first(begin, begin), begin);
+
+            // Every position and every character of the set is found, both
+            // inside whole blocks and in the remaining characters
+            for (std::size_t i = 0; i < text.size(); ++i) {
+                for (auto const c : set_chars) {
+                    text[i] = c;
+                    EXPECT_EQ(set.find_first(begin, end), begin + i);
+                    EXPECT_EQ(set.find_first(begin + i + 1, end), end);
+                    text[i] = 'x';
+                }
+            }
+        }
+    }
+}
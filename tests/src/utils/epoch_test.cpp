@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <booleval/exceptions.hpp>
+#include <booleval/utils/epoch.hpp>
+
+class EpochTest : public testing::Test {
+public:
+    struct tracked {
+        explicit tracked(int& destroyed) : destroyed_(destroyed) {}
+        ~tracked() { ++destroyed_; }
+
+    private:
+        int& destroyed_;
+    };
+};
+
+TEST_F(EpochTest, ReaderSlots) {
+    using namespace booleval;
+
+    utils::epoch_domain domain(2);
+    auto const first  = domain.acquire_slot();
+    auto const second = domain.acquire_slot();
+    EXPECT_NE(first, second);
+    EXPECT_THROW(static_cast<void>(domain.acquire_slot()), too_many_readers);
+
+    domain.release_slot(first);
+    EXPECT_EQ(domain.acquire_slot(), first);
+}
+
+TEST_F(EpochTest, RetireWithoutReaders) {
+    using namespace booleval;
+
+    int destroyed{ 0 };
+    utils::epoch_domain domain;
+
+    domain.retire(new tracked(destroyed));
+    EXPECT_EQ(destroyed, 1);
+    EXPECT_EQ(domain.retired(), 0U);
+
+    domain.retire<tracked>(nullptr);
+    EXPECT_EQ(domain.retired(), 0U);
+}
+
+TEST_F(EpochTest, RetireWhileReading) {
+    using namespace booleval;
+
+    int destroyed{ 0 };
+    utils::epoch_domain domain;
+
+    auto const reader = domain.acquire_slot();
+    domain.enter(reader);
+
+    // Object retired while the reader is inside its critical section is kept
+    domain.retire(new tracked(destroyed));
+    EXPECT_EQ(destroyed, 0);
+    EXPECT_EQ(domain.retired(), 1U);
+
+    // Reader entering after the retirement can not see the object
+    auto const late = domain.acquire_slot();
+    domain.enter(late);
+
+    domain.leave(reader);
+    EXPECT_EQ(domain.reclaim(), 0U);
+    EXPECT_EQ(destroyed, 1);
+
+    domain.leave(late);
+    domain.release_slot(late);
+    domain.release_slot(reader);
+}
+
+TEST_F(EpochTest, DestroyRetiredOnDestruction) {
+    using namespace booleval;
+
+    int destroyed{ 0 };
+    {
+        utils::epoch_domain domain;
+        auto const reader = domain.acquire_slot();
+        domain.enter(reader);
+        domain.retire(new tracked(destroyed));
+        domain.retire(new tracked(destroyed));
+        EXPECT_EQ(destroyed, 0);
+        domain.leave(reader);
+    }
+    EXPECT_EQ(destroyed, 2);
+}
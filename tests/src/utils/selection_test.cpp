@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/utils/selection.hpp>
+
+class SelectionTest : public testing::Test {};
+
+TEST_F(SelectionTest, DefaultConstructor) {
+    using namespace booleval::utils;
+
+    selection rows;
+    EXPECT_TRUE(rows.empty());
+    EXPECT_EQ(rows.mask(), 0U);
+    EXPECT_EQ(rows.count(), 0U);
+    EXPECT_EQ(rows.begin(), rows.end());
+}
+
+TEST_F(SelectionTest, First) {
+    using namespace booleval::utils;
+
+    EXPECT_EQ(selection::first(0).mask(), 0U);
+    EXPECT_EQ(selection::first(3).mask(), 0b111U);
+    EXPECT_EQ(selection::first(64).mask(), ~uint64_t{ 0 });
+    EXPECT_EQ(selection::first(64).count(), 64U);
+}
+
+TEST_F(SelectionTest, CountAndTest) {
+    using namespace booleval::utils;
+
+    selection const rows((uint64_t{ 1 } << 63) | 0b1001);
+    EXPECT_FALSE(rows.empty());
+    EXPECT_EQ(rows.count(), 3U);
+    EXPECT_TRUE(rows.test(0));
+    EXPECT_FALSE(rows.test(1));
+    EXPECT_TRUE(rows.test(3));
+    EXPECT_TRUE(rows.test(63));
+}
+
+TEST_F(SelectionTest, Iteration) {
+    using namespace booleval::utils;
+
+    selection const rows((uint64_t{ 1 } << 63) | (uint64_t{ 1 } << 32) | 0b1001);
+
+    std::vector<std::size_t> indices;
+    for (auto const index : rows) {
+        indices.push_back(index);
+    }
+    EXPECT_EQ(indices, (std::vector<std::size_t>{ 0, 3, 32, 63 }));
+
+    std::vector<std::size_t> visited;
+    rows.for_each([&](std::size_t const index) {
+        visited.push_back(index);
+    });
+    EXPECT_EQ(visited, indices);
+}
+
+TEST_F(SelectionTest, Combinators) {
+    using namespace booleval::utils;
+
+    selection const lhs(0b1100);
+    selection const rhs(0b1010);
+
+    EXPECT_EQ(lhs & rhs, selection(0b1000));
+    EXPECT_EQ(lhs | rhs, selection(0b1110));
+    EXPECT_EQ(lhs.without(rhs), selection(0b0100));
+    EXPECT_TRUE(lhs.contains(lhs & rhs));
+    EXPECT_FALSE(lhs.contains(rhs));
+    EXPECT_NE(lhs, rhs);
+}
+
+TEST_F(SelectionTest, BitUtils) {
+    using namespace booleval::utils;
+
+    EXPECT_EQ(popcount(0), 0U);
+    EXPECT_EQ(popcount(~uint64_t{ 0 }), 64U);
+    EXPECT_EQ(popcount(0b1011), 3U);
+
+    EXPECT_EQ(countr_zero(1), 0U);
+    EXPECT_EQ(countr_zero(0b1000), 3U);
+    EXPECT_EQ(countr_zero(uint64_t{ 1 } << 63), 63U);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <booleval/utils/thread_pool.hpp>
+
+class ThreadPoolTest : public testing::Test {};
+
+TEST_F(ThreadPoolTest, Concurrency) {
+    using namespace booleval::utils;
+
+    thread_pool none(0);
+    EXPECT_EQ(none.concurrency(), 1U);
+
+    thread_pool pool(3);
+    EXPECT_EQ(pool.concurrency(), 4U);
+}
+
+TEST_F(ThreadPoolTest, ParallelFor) {
+    using namespace booleval::utils;
+
+    for (std::size_t const workers : { 0U, 1U, 4U }) {
+        thread_pool pool(workers);
+
+        for (std::size_t const count : { 0U, 1U, 3U, 1000U }) {
+            std::vector<std::atomic<int>> executed(count);
+            pool.parallel_for(count, [&](std::size_t const index) {
+                ++executed[index];
+            });
+
+            for (auto const& times : executed) {
+                EXPECT_EQ(times.load(), 1);
+            }
+        }
+    }
+}
+
+TEST_F(ThreadPoolTest, ReusedForManyCalls) {
+    using namespace booleval::utils;
+
+    thread_pool pool(2);
+
+    std::atomic<std::size_t> sum{ 0 };
+    for (std::size_t i = 0; i < 200; ++i) {
+        pool.parallel_for(10, [&](std::size_t const index) {
+            sum += index;
+        });
+    }
+    EXPECT_EQ(sum.load(), 200U * 45U);
+}
+
+TEST_F(ThreadPoolTest, Exception) {
+    using namespace booleval::utils;
+
+    thread_pool pool(2);
+
+    std::atomic<std::size_t> executed{ 0 };
+    EXPECT_THROW(
+        pool.parallel_for(100, [&](std::size_t const index) {
+            ++executed;
+            if (42 == index) {
+                throw std::runtime_error("task failed");
+            }
+        }),
+        std::runtime_error
+    );
+    EXPECT_EQ(executed.load(), 100U);
+
+    // Pool remains usable after a task has thrown
+    executed = 0;
+    pool.parallel_for(10, [&](std::size_t) {
+        ++executed;
+    });
+    EXPECT_EQ(executed.load(), 10U);
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <gtest/gtest.h>
+#include <booleval/utils/type_id.hpp>
+
+class TypeIdTest : public testing::Test {};
+
+TEST_F(TypeIdTest, SameType) {
+    using namespace booleval::utils;
+
+    EXPECT_EQ(type_id_of<int>(), type_id_of<int>());
+    EXPECT_EQ(type_id_of<std::string>(), type_id_of<std::string>());
+    EXPECT_EQ(type_id_of<int>(), type_id_of<int const>());
+}
+
+TEST_F(TypeIdTest, DifferentTypes) {
+    using namespace booleval::utils;
+
+    EXPECT_NE(type_id_of<int>(), type_id_of<unsigned int>());
+    EXPECT_NE(type_id_of<int>(), type_id_of<int*>());
+    EXPECT_NE(type_id_of<std::string>(), type_id_of<std::string_view>());
+}